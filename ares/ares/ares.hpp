@@ -31,6 +31,7 @@
 #include <nall/dsp/iir/one-pole.hpp>
 #include <nall/dsp/iir/biquad.hpp>
 #include <nall/dsp/resampler/cubic.hpp>
+#include <nall/dsp/resampler/sinc.hpp>
 #include <nall/hash/crc32.hpp>
 #include <nall/hash/sha256.hpp>
 using namespace nall;
@@ -46,7 +47,11 @@ namespace ares {
 
   //incremented only when serialization format changes
   static const u32    SerializerSignature = 0x31545342;  //"BST1" (little-endian)
-  static const string SerializerVersion   = "123.1";
+  static const string SerializerVersion   = "123.3";
+  //previous formats; still accepted when unserializing by cores whose layout did not change since:
+  //123.2 only lacks the Nintendo 64 RDP tile and TMEM state, and 123.1 also stored entire thread stacks
+  static const string SerializerVersionCompatible = "123.2";
+  static const string SerializerVersionFullStack  = "123.1";
 
   namespace VFS {
     using Pak = shared_pointer<vfs::directory>;
@@ -1,6 +1,7 @@
 auto Stream::setChannels(u32 channels) -> void {
   _channels.reset();
   _channels.resize(channels);
+  resetBuffer();
 }
 
 auto Stream::setFrequency(f64 frequency) -> void {
@@ -10,13 +11,16 @@ auto Stream::setFrequency(f64 frequency) -> void {
 
 auto Stream::setResamplerFrequency(f64 resamplerFrequency) -> void {
   _resamplerFrequency = resamplerFrequency;
+  resetBuffer();
 
   for(auto& channel : _channels) {
     channel.nyquist.reset();
-    channel.resampler.reset(_frequency, _resamplerFrequency);
+    if(_resampler == Resampler::Cubic) channel.cubic.reset(_frequency, _resamplerFrequency);
+    if(_resampler == Resampler::Sinc) channel.sinc.reset(_frequency, _resamplerFrequency);
   }
 
-  if(_frequency >= _resamplerFrequency * 2) {
+  //the sinc resampler performs its own band-limiting.
+  if(_resampler == Resampler::Cubic && _frequency >= _resamplerFrequency * 2) {
     //add a low-pass filter to prevent aliasing during resampling
     f64 cutoffFrequency = min(25000.0, _resamplerFrequency / 2.0 - 2000.0);
     for(auto& channel : _channels) {
@@ -31,6 +35,11 @@ auto Stream::setResamplerFrequency(f64 resamplerFrequency) -> void {
   }
 }
 
+auto Stream::setResampler(Resampler resampler) -> void {
+  _resampler = resampler;
+  setResamplerFrequency(_resamplerFrequency);
+}
+
 auto Stream::setMuted(bool muted) -> void {
   _muted = muted;
 }
@@ -100,32 +109,89 @@ auto Stream::addHighShelfFilter(f64 cutoffFrequency, u32 order, f64 gain, f64 sl
 }
 
 auto Stream::pending() const -> bool {
-  return _channels && _channels[0].resampler.pending();
+  if(!_channels) return false;
+  if(_resampler == Resampler::Sinc) return _channels[0].sinc.pending();
+  return _channels[0].cubic.pending();
+}
+
+auto Stream::available() const -> u32 {
+  if(!_channels) return 0;
+  if(_resampler == Resampler::Sinc) return _channels[0].sinc.size();
+  return _channels[0].cubic.size();
 }
 
 auto Stream::read(f64 samples[]) -> u32 {
   for(u32 c : range(_channels.size())) {
-    samples[c] = _channels[c].resampler.read() * !muted();
+    auto& channel = _channels[c];
+    samples[c] = (_resampler == Resampler::Sinc ? channel.sinc.read() : channel.cubic.read()) * !muted();
   }
   return _channels.size();
 }
 
+//reads up to the requested number of interleaved frames; returns the number of frames read.
+auto Stream::read(f64 samples[], u32 frames) -> u32 {
+  frames = min(frames, available());
+  u32 stride = _channels.size();
+  for(u32 c : range(stride)) {
+    auto& channel = _channels[c];
+    if(_resampler == Resampler::Sinc) {
+      for(u32 n : range(frames)) samples[n * stride + c] = channel.sinc.read() * !muted();
+    } else {
+      for(u32 n : range(frames)) samples[n * stride + c] = channel.cubic.read() * !muted();
+    }
+  }
+  return frames;
+}
+
 auto Stream::write(const f64 samples[]) -> void {
-  for(u32 c : range(_channels.size())) {
-    f64 sample = samples[c] + 1e-25;  //constant offset used to suppress denormals
-    for(auto& filter : _channels[c].filters) {
+  write(samples, 1);
+}
+
+//writes interleaved frames. each filter runs over the entire block in turn,
+//which is equivalent to running the filter chain once per sample.
+auto Stream::write(const f64 samples[], u32 frames) -> void {
+  u32 stride = _channels.size();
+  if(_block.size() < frames) _block.resize(frames);
+  auto block = _block.data();
+
+  for(u32 c : range(stride)) {
+    auto& channel = _channels[c];
+    for(u32 n : range(frames)) {
+      block[n] = samples[n * stride + c] + 1e-25;  //constant offset used to suppress denormals
+    }
+    for(auto& filter : channel.filters) {
       switch(filter.mode) {
-      case Filter::Mode::OnePole: sample = filter.onePole.process(sample); break;
-      case Filter::Mode::Biquad: sample = filter.biquad.process(sample); break;
+      case Filter::Mode::OnePole:
+        for(u32 n : range(frames)) block[n] = filter.onePole.process(block[n]);
+        break;
+      case Filter::Mode::Biquad:
+        for(u32 n : range(frames)) block[n] = filter.biquad.process(block[n]);
+        break;
       }
     }
-    for(auto& filter : _channels[c].nyquist) {
-      sample = filter.process(sample);
+    for(auto& filter : channel.nyquist) {
+      for(u32 n : range(frames)) block[n] = filter.process(block[n]);
     }
-    _channels[c].resampler.write(sample);
+    if(_resampler == Resampler::Sinc) channel.sinc.write(block, frames);
+    if(_resampler == Resampler::Cubic) channel.cubic.write(block, frames);
   }
 
   //if there are samples pending, then alert the frontend to possibly process them.
   //this will generally happen when every audio stream has pending samples to be mixed.
   if(pending()) platform->audio(shared());
 }
+
+//writes any frames buffered by frame().
+auto Stream::flush() -> void {
+  if(!_buffered) return;
+  u32 frames = _buffered;
+  _buffered = 0;
+  write(_buffer.data(), frames);
+}
+
+auto Stream::resetBuffer() -> void {
+  //batch roughly one millisecond of audio, bounded by the resampler queue (20ms).
+  _bufferFrames = max(1.0, _frequency / 1000.0);
+  _buffer.resize(_bufferFrames * _channels.size());
+  _buffered = 0;
+}
@@ -5,11 +5,13 @@ struct Stream : Audio {
   auto channels() const -> u32 { return _channels.size(); }
   auto frequency() const -> f64 { return _frequency; }
   auto resamplerFrequency() const -> f64 { return _resamplerFrequency; }
+  auto resampler() const -> Resampler { return _resampler; }
   auto muted() const -> bool { return _muted; }
 
   auto setChannels(u32 channels) -> void;
   auto setFrequency(f64 frequency) -> void;
   auto setResamplerFrequency(f64 resamplerFrequency) -> void;
+  auto setResampler(Resampler resampler) -> void;
   auto setMuted(bool muted) -> void;
 
   auto resetFilters() -> void;
@@ -19,14 +21,20 @@ struct Stream : Audio {
   auto addHighShelfFilter(f64 cutoffFrequency, u32 order, f64 gain, f64 slope) -> void;
 
   auto pending() const -> bool;
+  auto available() const -> u32;
   auto read(f64 samples[]) -> u32;
+  auto read(f64 samples[], u32 frames) -> u32;
   auto write(const f64 samples[]) -> void;
+  auto write(const f64 samples[], u32 frames) -> void;
+  auto flush() -> void;
 
+  //frames are buffered (up to ~1ms) so that filtering, resampling and mixing run over whole blocks.
   template<typename... P>
   auto frame(P&&... p) -> void {
-    if(runAhead()) return;
-    f64 samples[sizeof...(p)] = {forward<P>(p)...};
-    write(samples);
+    if(runAhead() || !_buffer) return;
+    auto samples = _buffer.data() + _buffered * sizeof...(p);
+    ((*samples++ = forward<P>(p)), ...);
+    if(++_buffered >= _bufferFrames) flush();
   }
 
 protected:
@@ -40,10 +48,18 @@ protected:
   struct Channel {
     vector<Filter> filters;
     vector<DSP::IIR::Biquad> nyquist;
-    DSP::Resampler::Cubic resampler;
+    DSP::Resampler::Cubic cubic;
+    DSP::Resampler::Sinc sinc;
   };
+  auto resetBuffer() -> void;
+
   vector<Channel> _channels;
+  vector<f64> _buffer;  //interleaved frames awaiting write()
+  vector<f64> _block;   //single channel of the block being written
+  u32 _bufferFrames = 1;
+  u32 _buffered = 0;
   f64 _frequency = 48000.0;
   f64 _resamplerFrequency = 48000.0;
+  Resampler _resampler = Resampler::Cubic;
   bool _muted = false;
 };
@@ -1,6 +1,8 @@
 namespace ares::Core {
+  #include <ares/node/system.cpp>
   namespace Video {
     #include <ares/node/video/sprite.cpp>
+    #include <ares/node/video/kernels.cpp>
     #include <ares/node/video/screen.cpp>
   }
   namespace Audio {
@@ -15,6 +15,8 @@ namespace ares::Core {
   namespace Audio {
     struct Audio;
     struct Stream;
+    //Cubic is cheap and suits sources near the output rate; Sinc band-limits high-rate sources itself.
+    enum class Resampler : u32 { Cubic, Sinc };
   }
   namespace Input {
     struct Input;
@@ -61,6 +63,7 @@ namespace ares::Node {
   namespace Audio {
     using Audio          = shared_pointer<Core::Audio::Audio>;
     using Stream         = shared_pointer<Core::Audio::Stream>;
+    using Resampler      = Core::Audio::Resampler;
   }
   namespace Input {
     using Input          = shared_pointer<Core::Input::Input>;
@@ -0,0 +1,17 @@
+auto System::power(bool reset) -> void {
+  flushAudio();
+  if(_power) return _power(reset);
+}
+
+auto System::unserialize(serializer& s) -> bool {
+  flushAudio();
+  if(_unserialize) return _unserialize(s);
+  return false;
+}
+
+//audio streams buffer up to ~1ms of frames that are not part of the serialized state.
+//these frames were generated before the power cycle or state load, so write them out
+//now rather than mixing them into the audio produced afterward.
+auto System::flushAudio() -> void {
+  for(auto& stream : find<Node::Audio::Stream>()) stream->flush();
+}
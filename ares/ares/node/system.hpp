@@ -4,11 +4,11 @@ struct System : Object {
 
   auto game() -> string { if(_game) return _game(); return {}; }
   auto run() -> void { if(_run) return _run(); }
-  auto power(bool reset = false) -> void { if(_power) return _power(reset); }
+  auto power(bool reset = false) -> void;
   auto save() -> void { if(_save) return _save(); }
   auto unload() -> void { if(_unload) return _unload(); }
   auto serialize(bool synchronize = true) -> serializer { if(_serialize) return _serialize(synchronize); return {}; }
-  auto unserialize(serializer& s) -> bool { if(_unserialize) return _unserialize(s); return false; }
+  auto unserialize(serializer& s) -> bool;
 
   auto setGame(function<string ()> game) -> void { _game = game; }
   auto setRun(function<void ()> run) -> void { _run = run; }
@@ -19,6 +19,8 @@ struct System : Object {
   auto setUnserialize(function<bool (serializer&)> unserialize) -> void { _unserialize = unserialize; }
 
 protected:
+  auto flushAudio() -> void;
+
   function<string ()> _game;
   function<void ()> _run;
   function<void (bool)> _power;
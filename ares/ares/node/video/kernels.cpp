@@ -0,0 +1,104 @@
+//pixel kernels used by Screen::refresh().
+//the palette gather uses AVX2 when the host supports it (detected at runtime);
+//blending uses SSE2, and rotation transposes the canvas in cache-sized tiles.
+
+namespace Kernel {
+
+//per-channel average of two ARGB8888 pixels, computed as a single 32-bit operation.
+alwaysinline auto average(u32 a, u32 b) -> u32 {
+  return (a + b - ((a ^ b) & 0x01010101)) >> 1;
+}
+
+#if defined(__SSE2__)
+alwaysinline auto average(__m128i a, __m128i b) -> __m128i {
+  auto carry = _mm_and_si128(_mm_xor_si128(a, b), _mm_set1_epi32(0x01010101));
+  return _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(a, b), carry), 1);
+}
+#endif
+
+inline auto paletteScalar(u32* target, const u32* source, const u32* palette, u32 length) -> void {
+  for(u32 x : range(length)) target[x] = palette[source[x]];
+}
+
+#if defined(ARCHITECTURE_AMD64) && (defined(COMPILER_GCC) || defined(COMPILER_CLANG))
+__attribute__((target("avx2")))
+inline auto paletteAVX2(u32* target, const u32* source, const u32* palette, u32 length) -> void {
+  u32 x = 0;
+  for(; x + 8 <= length; x += 8) {
+    auto index = _mm256_loadu_si256((const __m256i*)(source + x));
+    auto color = _mm256_i32gather_epi32((const int*)palette, index, 4);
+    _mm256_storeu_si256((__m256i*)(target + x), color);
+  }
+  for(; x < length; x++) target[x] = palette[source[x]];
+}
+#endif
+
+//target[x] = palette[source[x]]
+inline auto palette(u32* target, const u32* source, const u32* palette, u32 length) -> void {
+  #if defined(ARCHITECTURE_AMD64) && (defined(COMPILER_GCC) || defined(COMPILER_CLANG))
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  if(avx2) return paletteAVX2(target, source, palette, length);
+  #endif
+  return paletteScalar(target, source, palette, length);
+}
+
+//target[x] = average(target[x], source[x])
+inline auto blend(u32* target, const u32* source, u32 length) -> void {
+  u32 x = 0;
+  #if defined(__SSE2__)
+  for(; x + 4 <= length; x += 4) {
+    auto a = _mm_loadu_si128((const __m128i*)(target + x));
+    auto b = _mm_loadu_si128((const __m128i*)(source + x));
+    _mm_storeu_si128((__m128i*)(target + x), average(a, b));
+  }
+  #endif
+  for(; x < length; x++) target[x] = average(target[x], source[x]);
+}
+
+//target[x] = average(target[x], target[x + 1]); the final pixel is averaged with itself.
+//each store only covers pixels whose right neighbors have already been loaded.
+inline auto bleed(u32* target, u32 length) -> void {
+  u32 x = 0;
+  #if defined(__SSE2__)
+  for(; x + 5 <= length; x += 4) {
+    auto a = _mm_loadu_si128((const __m128i*)(target + x + 0));
+    auto b = _mm_loadu_si128((const __m128i*)(target + x + 1));
+    _mm_storeu_si128((__m128i*)(target + x), average(a, b));
+  }
+  #endif
+  for(; x < length; x++) target[x] = average(target[x], target[x + (x != length - 1)]);
+}
+
+//rotates a width x height image (rows pitch pixels apart) counter-clockwise by 90, 180 or 270 degrees.
+//the result is tightly packed. 90 and 270 degree rotations write column-major;
+//tiling keeps both sides of the transpose in cache.
+inline auto rotate(u32* target, const u32* source, u32 pitch, u32 width, u32 height, u32 rotation) -> void {
+  static constexpr u32 Tile = 32;
+
+  if(rotation == 180) {
+    auto output = target + width * height;
+    for(u32 y : range(height)) {
+      auto input = source + y * pitch;
+      for(u32 x : range(width)) *--output = input[x];
+    }
+    return;
+  }
+
+  for(u32 ty = 0; ty < height; ty += Tile) {
+    u32 tyEnd = min(ty + Tile, height);
+    for(u32 tx = 0; tx < width; tx += Tile) {
+      u32 txEnd = min(tx + Tile, width);
+      for(u32 y = ty; y < tyEnd; y++) {
+        auto input = source + y * pitch;
+        if(rotation == 90) {
+          for(u32 x = tx; x < txEnd; x++) target[(width - 1 - x) * height + y] = input[x];
+        }
+        if(rotation == 270) {
+          for(u32 x = tx; x < txEnd; x++) target[x * height + (height - 1 - y)] = input[x];
+        }
+      }
+    }
+  }
+}
+
+}
@@ -6,9 +6,11 @@ Screen::Screen(string name, u32 width, u32 height) : Video(name) {
     _inputA = new u32[width * height]();
     _inputB = new u32[width * height]();
     _output = new u32[width * height]();
+    _line   = new u32[width]();
     _rotate = new u32[width * height]();
 
     if constexpr(ares::Video::Threaded) {
+      _inputC = new u32[width * height]();
       _thread = nall::thread::create({&Screen::main, this});
     }
   }
@@ -16,25 +18,30 @@ Screen::Screen(string name, u32 width, u32 height) : Video(name) {
 
 Screen::~Screen() {
   if constexpr(ares::Video::Threaded) {
-    if(_canvasWidth && _canvasHeight) {
-      _kill = true;
-      _thread.join();
-    }
+    if(_canvasWidth && _canvasHeight) quit();
   }
 }
 
 auto Screen::main(uintptr_t) -> void {
-  while(!_kill) {
-    usleep(1);
-    if(_frame) {
-      refresh();
-      _frame = false;
-    }
+  while(true) {
+    unique_lock<mutex> lock(_frameMutex);
+    _frameCondition.wait(lock, [&] { return _frame || _kill; });
+    if(_kill) return;
+    //_inputB was cleared by the previous refresh: hand it back to frame() via _inputC.
+    _inputB.swap(_inputC);
+    _frame = false;
+    lock.unlock();
+    refresh();
   }
 }
 
 auto Screen::quit() -> void {
-  _kill = true;
+  {
+    lock_guard<mutex> lock(_frameMutex);
+    if(_kill) return;
+    _kill = true;
+  }
+  _frameCondition.notify_one();
   _thread.join();
 }
 
@@ -42,6 +49,7 @@ auto Screen::power() -> void {
   lock_guard<recursive_mutex> lock(_mutex);
   memory::fill<u32>(_inputA.data(), _canvasWidth * _canvasHeight, _fillColor);
   memory::fill<u32>(_inputB.data(), _canvasWidth * _canvasHeight, _fillColor);
+  if(_inputC) memory::fill<u32>(_inputC.data(), _canvasWidth * _canvasHeight, _fillColor);
   memory::fill<u32>(_output.data(), _canvasWidth * _canvasHeight, _fillColor);
   memory::fill<u32>(_rotate.data(), _canvasWidth * _canvasHeight, _fillColor);
 }
@@ -69,6 +77,8 @@ auto Screen::setRefresh(function<void ()> refresh) -> void {
 
 auto Screen::setViewport(u32 x, u32 y, u32 width, u32 height) -> void {
   lock_guard<recursive_mutex> lock(_mutex);
+  //every input buffer must be cleared once in full before partial clearing resumes.
+  if(x != _viewportX || y != _viewportY || width != _viewportWidth || height != _viewportHeight) _clearCanvas = 3;
   _viewportX = x;
   _viewportY = y;
   _viewportWidth  = width;
@@ -164,17 +174,28 @@ auto Screen::colors(u32 colors, function<n64 (n32)> color) -> void {
   _palette.reset();
 }
 
+//triple buffered: the emulator draws into _inputA, the refresh thread reads _inputB,
+//and completed frames are exchanged through _inputC without waiting on refresh().
 auto Screen::frame() -> void {
   if(runAhead()) return;
-  while(_frame) spinloop();
 
-  lock_guard<recursive_mutex> lock(_mutex);
-  _inputA.swap(_inputB);
-  _frame = true;
   if constexpr(!ares::Video::Threaded) {
-    refresh();
-    _frame = false;
+    lock_guard<recursive_mutex> lock(_mutex);
+    _inputA.swap(_inputB);
+    return refresh();
+  }
+
+  bool dropped;
+  {
+    lock_guard<mutex> lock(_frameMutex);
+    _inputA.swap(_inputC);
+    dropped = _frame;
+    _frame = true;
   }
+  _frameCondition.notify_one();
+
+  //the refresh thread fell behind: the previous frame was skipped and was never cleared.
+  if(dropped) memory::fill<u32>(_inputA.data(), _canvasWidth * _canvasHeight, _fillColor);
 }
 
 auto Screen::refresh() -> void {
@@ -184,58 +205,39 @@ auto Screen::refresh() -> void {
   refreshPalette();
   if(_refresh) _refresh();
 
-  auto viewX = _viewportX;
-  auto viewY = _viewportY;
-  auto viewWidth  = _viewportWidth;
-  auto viewHeight = _viewportHeight;
+  //only the viewport is sent to the platform, so only the viewport is converted and cleared.
+  auto viewX = min(_viewportX, _canvasWidth);
+  auto viewY = min(_viewportY, _canvasHeight);
+  auto viewWidth  = min(_viewportWidth,  _canvasWidth  - viewX);
+  auto viewHeight = min(_viewportHeight, _canvasHeight - viewY);
 
   auto pitch  = _canvasWidth;
-  auto width  = _canvasWidth;
-  auto height = _canvasHeight;
   auto input  = _inputB.data();
   auto output = _output.data();
 
-  for(u32 y : range(height)) {
-    auto source = input  + y * pitch;
-    auto target = output + y * width;
+  auto palette = _palette.data();
+  for(u32 y : range(viewY, viewY + viewHeight)) {
+    auto source = input  + y * pitch + viewX;
+    auto target = output + y * pitch + viewX;
 
     if(_interlace) {
       if((_interlaceField & 1) == (y & 1)) {
-        for(u32 x : range(width)) {
-          auto color = _palette[*source++];
-          *target++ = color;
-        }
+        Kernel::palette(target, source, palette, viewWidth);
       }
     } else if(_progressive && _progressiveDouble) {
-      source = input + (y & ~1) * pitch;
-      for(u32 x : range(width)) {
-        auto color = _palette[*source++];
-        *target++ = color;
-      }
+      source = input + (y & ~1) * pitch + viewX;
+      Kernel::palette(target, source, palette, viewWidth);
     } else if(_interframeBlending) {
-      n32 mask = 1 << 24 | 1 << 16 | 1 << 8 | 1 << 0;
-      for(u32 x : range(width)) {
-        auto a = *target;
-        auto b = _palette[*source++];
-        *target++ = (a + b - ((a ^ b) & mask)) >> 1;
-      }
+      Kernel::palette(_line.data(), source, palette, viewWidth);
+      Kernel::blend(target, _line.data(), viewWidth);
     } else {
-      for(u32 x : range(width)) {
-        auto color = _palette[*source++];
-        *target++ = color;
-      }
+      Kernel::palette(target, source, palette, viewWidth);
     }
   }
 
   if(_colorBleed) {
-    n32 mask = 1 << 24 | 1 << 16 | 1 << 8 | 1 << 0;
-    for(u32 y : range(height)) {
-      auto target = output + y * width;
-      for(u32 x : range(width)) {
-        auto a = target[x];
-        auto b = target[x + (x != width - 1)];
-        target[x] = (a + b - ((a ^ b) & mask)) >> 1;
-      }
+    for(u32 y : range(viewY, viewY + viewHeight)) {
+      Kernel::bleed(output + y * pitch + viewX, viewWidth);
     }
   }
 
@@ -245,13 +247,13 @@ auto Screen::refresh() -> void {
     n32 alpha = 255u << 24;
     for(int y : range(sprite->height())) {
       s32 pixelY = sprite->y() + y;
-      if(pixelY < 0 || pixelY >= height) continue;
+      if(pixelY < (s32)viewY || pixelY >= (s32)(viewY + viewHeight)) continue;
 
       auto source = sprite->image().data() + y * sprite->width();
-      auto target = &output[pixelY * width];
+      auto target = &output[pixelY * pitch];
       for(s32 x : range(sprite->width())) {
         s32 pixelX = sprite->x() + x;
-        if(pixelX < 0 || pixelX >= width) continue;
+        if(pixelX < (s32)viewX || pixelX >= (s32)(viewX + viewWidth)) continue;
 
         auto pixel = source[x];
         if(pixel >> 24) target[pixelX] = alpha | pixel;
@@ -259,48 +261,23 @@ auto Screen::refresh() -> void {
     }
   }
 
-  if(_rotation == 90) {
-    //rotate left
-    for(u32 y : range(height)) {
-      auto source = output + y * width;
-      for(u32 x : range(width)) {
-        auto target = _rotate.data() + (width - 1 - x) * height + y;
-        *target = *source++;
-      }
-    }
-    output = _rotate.data();
-    swap(width, height);
-    swap(viewWidth, viewHeight);
+  if(_rotation == 90 || _rotation == 180 || _rotation == 270) {
+    Kernel::rotate(_rotate.data(), output + viewY * pitch + viewX, pitch, viewWidth, viewHeight, _rotation);
+    if(_rotation != 180) swap(viewWidth, viewHeight);
+    platform->video(shared(), _rotate.data(), viewWidth * sizeof(u32), viewWidth, viewHeight);
+  } else {
+    platform->video(shared(), output + viewY * pitch + viewX, pitch * sizeof(u32), viewWidth, viewHeight);
   }
 
-  if(_rotation == 180) {
-    //rotate upside down
-    for(u32 y : range(height)) {
-      auto source = output + y * width;
-      for(u32 x : range(width)) {
-        auto target = _rotate.data() + (height - 1 - y) * width + (width - 1 - x);
-        *target = *source++;
-      }
+  //pixels the emulator drew outside of a previous viewport may now be visible: clear everything.
+  if(_clearCanvas) {
+    _clearCanvas--;
+    memory::fill<u32>(input, _canvasWidth * _canvasHeight, _fillColor);
+  } else {
+    for(u32 y : range(viewY, viewY + viewHeight)) {
+      memory::fill<u32>(input + y * pitch + viewX, viewWidth, _fillColor);
     }
-    output = _rotate.data();
   }
-
-  if(_rotation == 270) {
-    //rotate right
-    for(u32 y : range(height)) {
-      auto source = output + y * width;
-      for(u32 x : range(width)) {
-        auto target = _rotate.data() + x * height + (height - 1 - y);
-        *target = *source++;
-      }
-    }
-    output = _rotate.data();
-    swap(width, height);
-    swap(viewWidth, viewHeight);
-  }
-
-  platform->video(shared(), output + viewX + viewY * width, width * sizeof(u32), viewWidth, viewHeight);
-  memory::fill<u32>(_inputB.data(), width * height, _fillColor);
 }
 
 auto Screen::refreshPalette() -> void {
@@ -82,9 +82,11 @@ protected:
   u32  _rotation = 0;  //counter-clockwise (90 = left, 270 = right)
 
   function<n64 (n32)> _color;
-  unique_pointer<u32> _inputA;
-  unique_pointer<u32> _inputB;
+  unique_pointer<u32> _inputA;  //frame being drawn by the emulator
+  unique_pointer<u32> _inputB;  //frame being refreshed
+  unique_pointer<u32> _inputC;  //completed frame awaiting refresh (threaded only)
   unique_pointer<u32> _output;
+  unique_pointer<u32> _line;
   unique_pointer<u32> _rotate;
   unique_pointer<u32[]> _palette;
   vector<Node::Video::Sprite> _sprites;
@@ -92,8 +94,10 @@ protected:
 //unserialized:
   nall::thread _thread;
   recursive_mutex _mutex;
+  mutex _frameMutex;
+  condition_variable _frameCondition;
   atomic<bool> _kill = false;
-  atomic<bool> _frame = false;
+  bool _frame = false;  //_inputC holds a frame that has not been refreshed yet
   function<void ()> _refresh;
   bool _progressive = false;
   bool _progressiveDouble = false;
@@ -103,4 +107,5 @@ protected:
   u32  _viewportY = 0;
   u32  _viewportWidth = 0;
   u32  _viewportHeight = 0;
+  u32  _clearCanvas = 0;  //number of refreshes that must clear the entire input buffer
 };
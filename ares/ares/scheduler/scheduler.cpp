@@ -135,3 +135,7 @@ inline auto Scheduler::getSynchronize() -> bool {
 inline auto Scheduler::setSynchronize(bool synchronize) -> void {
   _synchronize = synchronize;
 }
+
+inline auto Scheduler::setFullStack(bool fullStack) -> void {
+  _fullStack = fullStack;
+}
@@ -31,6 +31,7 @@ struct Scheduler {
 
   auto getSynchronize() -> bool;
   auto setSynchronize(bool) -> void;
+  auto setFullStack(bool) -> void;
 
 private:
   cothread_t _host = nullptr;     //program thread (used to exit scheduler)
@@ -40,6 +41,7 @@ private:
   Event _event = Event::Step;
   vector<Thread*> _threads;
   bool _synchronize = false;
+  bool _fullStack = false;  //unserializing a state that stored entire thread stacks
 
   friend class Thread;
 };
@@ -94,26 +94,47 @@ inline auto Thread::synchronize(Thread& thread, P&&... p) -> void {
   if constexpr(sizeof...(p) > 0) synchronize(forward<P>(p)...);
 }
 
+//returns the offset of the lowest in-use byte of this thread's stack.
+//stacks grow downward from the end of the cothread, so only [offset, Size) must be serialized.
+//falls back to the entire stack when the stack pointer location of the libco backend is unknown.
+inline auto Thread::stackOffset() const -> u32 {
+  #if defined(ARCHITECTURE_AMD64) || defined(ARCHITECTURE_X86) || defined(ARCHITECTURE_ARM64)
+  #if defined(ARCHITECTURE_ARM64)
+  static constexpr u32 StackPointer = 20;  //stp x16,x30,[x1,#160]
+  #else
+  static constexpr u32 StackPointer = 0;   //mov [rsi],rsp
+  #endif
+  static constexpr u32 RedZone = 128;
+  //the running thread's saved stack pointer is stale.
+  if(co_active() == _handle) return Context;
+  auto offset = ((uintptr*)_handle)[StackPointer] - (uintptr)_handle;
+  if(offset >= Context + RedZone && offset <= Thread::Size) return offset - RedZone;
+  #endif
+  return Context;
+}
+
 inline auto Thread::serialize(serializer& s) -> void {
   s(_frequency);
   s(_scalar);
   s(_clock);
 
   if(!scheduler._synchronize) {
-    static u8 stack[Thread::Size];
     bool resume = co_active() == _handle;
 
-    if(s.reading()) {
-      s(stack);
+    //states prior to SerializerVersion 123.2 stored the entire cothread.
+    if(s.reading() && scheduler._fullStack) {
+      s(array_span<u8>{_handle, Thread::Size});
       s(resume);
-      memory::copy(_handle, stack, Thread::Size);
       if(resume) scheduler._resume = _handle;
+      return;
     }
 
-    if(s.writing()) {
-      memory::copy(stack, _handle, Thread::Size);
-      s(stack);
-      s(resume);
-    }
+    u32 offset = stackOffset();
+    s(offset);
+    if(offset < Context || offset > Thread::Size) offset = Context;
+    s(array_span<u8>{_handle, Context});
+    s(array_span<u8>{(u8*)_handle + offset, Thread::Size - offset});
+    s(resume);
+    if(s.reading() && resume) scheduler._resume = _handle;
   }
 }
@@ -3,6 +3,7 @@ struct Scheduler;
 struct Thread {
   enum : uintmax { Second = (uintmax)-1 >> 1 };
   enum : uintmax { Size = 16_KiB * sizeof(void*) };
+  enum : u32 { Context = 512 };  //bytes reserved for saved registers at the start of each cothread
 
   struct EntryPoint {
     cothread_t handle = nullptr;
@@ -37,6 +38,7 @@ struct Thread {
   auto synchronize() -> void;
   template<typename... P> auto synchronize(Thread&, P&&...) -> void;
 
+  auto stackOffset() const -> u32;
   auto serialize(serializer& s) -> void;
 
 protected:
@@ -13,8 +13,8 @@ namespace ares {
 #include "disassembler.cpp"
 
 ARM7TDMI::ARM7TDMI() {
-  armInitialize();
-  thumbInitialize();
+  static const bool initialized = (armInitialize(), thumbInitialize(), true);
+  (void)initialized;
 }
 
 auto ARM7TDMI::power() -> void {
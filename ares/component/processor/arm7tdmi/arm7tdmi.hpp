@@ -58,8 +58,8 @@ struct ARM7TDMI {
   auto fetch() -> void;
   auto instruction() -> void;
   auto exception(u32 mode, n32 address) -> void;
-  auto armInitialize() -> void;
-  auto thumbInitialize() -> void;
+  static auto armInitialize() -> void;
+  static auto thumbInitialize() -> void;
 
   //instructions-arm.cpp
   auto armALU(n4 mode, n4 target, n4 source, n32 data) -> void;
@@ -226,8 +226,37 @@ struct ARM7TDMI {
   b1  carry;
   b1  irq;
 
-  function<void (n32 opcode)> armInstruction[4096];
-  function<void ()> thumbInstruction[65536];
+  //decode tables, built once and shared by every instance.
+  //ARM handlers decode their operands from the opcode; Thumb operands are pre-decoded per opcode.
+  struct ARMHandler {
+    auto (*instruction)(ARM7TDMI& self, n32 opcode) -> void;
+    auto (*disassemble)(ARM7TDMI& self, n32 opcode) -> string;
+  };
+  struct ThumbHandler {
+    auto (*instruction)(ARM7TDMI& self, u16 operands) -> void;
+    auto (*disassemble)(ARM7TDMI& self, u16 operands) -> string;
+  };
+  static u8 armTable[4096];           //index into armHandlers (0 = unbound)
+  static ARMHandler armHandlers[32];
+  static u8 thumbTable[65536];        //index into thumbHandlers (0 = unbound)
+  static u16 thumbOperands[65536];    //operand fields, packed by thumbPack()
+  static ThumbHandler thumbHandlers[32];
+
+  template<typename... T> static auto thumbPack(T... operands) -> u16 {
+    static_assert((T::bits() + ... + 0) <= 16, "Thumb operands do not fit in 16 bits");
+    u32 data = 0, shift = 0;
+    ((data |= (u32)(operands & T::mask()) << shift, shift += T::bits()), ...);
+    return data;
+  }
+  template<typename T> static auto thumbUnpack(u16 data, u32& shift) -> T {
+    T value = data >> shift & T::mask();
+    shift += T::bits();
+    return value;
+  }
+  template<typename... T> static auto thumbUnpack(u16 data, tuple<T...>*) -> tuple<T...> {
+    u32 shift = 0;
+    return {thumbUnpack<T>(data, shift)...};
+  }
 
   //disassembler.cpp
   auto armDisassembleBranch(i24, n1) -> string;
@@ -275,9 +304,6 @@ struct ARM7TDMI {
   auto thumbDisassembleStackMultiple(n8, n1, n1) -> string;
   auto thumbDisassembleUndefined() -> string;
 
-  function<string (n32 opcode)> armDisassemble[4096];
-  function<string ()> thumbDisassemble[65536];
-
   n32 _pc;
   string _c;
 };
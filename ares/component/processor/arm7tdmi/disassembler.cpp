@@ -20,10 +20,10 @@ auto ARM7TDMI::disassembleInstruction(maybe<n32> pc, maybe<boolean> thumb) -> st
     n32 opcode = read(Word | Nonsequential, _pc & ~3);
     n12 index = (opcode & 0x0ff00000) >> 16 | (opcode & 0x000000f0) >> 4;
     _c = _conditions[opcode >> 28];
-    return pad(armDisassemble[index](opcode), -40);
+    return pad(armHandlers[armTable[index]].disassemble(*this, opcode), -40);
   } else {
     n16 opcode = read(Half | Nonsequential, _pc & ~1);
-    return pad(thumbDisassemble[opcode](), -40);
+    return pad(thumbHandlers[thumbTable[opcode]].disassemble(*this, thumbOperands[opcode]), -40);
   }
 }
 
@@ -40,9 +40,10 @@ auto ARM7TDMI::instruction() -> void {
   if(!pipeline.execute.thumb) {
     if(!TST(opcode.bit(28,31))) return;
     n12 index = (opcode & 0x0ff00000) >> 16 | (opcode & 0x000000f0) >> 4;
-    armInstruction[index](opcode);
+    armHandlers[armTable[index]].instruction(*this, opcode);
   } else {
-    thumbInstruction[(n16)opcode]();
+    n16 index = opcode;
+    thumbHandlers[thumbTable[index]].instruction(*this, thumbOperands[index]);
   }
 }
 
@@ -57,12 +58,26 @@ auto ARM7TDMI::exception(u32 mode, n32 address) -> void {
   r(15) = address;
 }
 
+u8 ARM7TDMI::armTable[4096];
+ARM7TDMI::ARMHandler ARM7TDMI::armHandlers[32];
+u8 ARM7TDMI::thumbTable[65536];
+u16 ARM7TDMI::thumbOperands[65536];
+ARM7TDMI::ThumbHandler ARM7TDMI::thumbHandlers[32];
+
 auto ARM7TDMI::armInitialize() -> void {
+  u32 handlers = 1;
   #define bind(id, name, ...) { \
     u32 index = (id & 0x0ff00000) >> 16 | (id & 0x000000f0) >> 4; \
-    assert(!armInstruction[index]); \
-    armInstruction[index] = [&](n32 opcode) { return armInstruction##name(arguments); }; \
-    armDisassemble[index] = [&](n32 opcode) { return armDisassemble##name(arguments); }; \
+    assert(!armTable[index]); \
+    static const u8 handler = [&] { \
+      assert(handlers < 32); \
+      armHandlers[handlers] = { \
+        [](ARM7TDMI& self, n32 opcode) -> void { return self.armInstruction##name(arguments); }, \
+        [](ARM7TDMI& self, n32 opcode) -> string { return self.armDisassemble##name(arguments); }, \
+      }; \
+      return handlers++; \
+    }(); \
+    armTable[index] = handler; \
   }
 
   #define pattern(s) \
@@ -355,7 +370,7 @@ auto ARM7TDMI::armInitialize() -> void {
 
   #define arguments
   for(n12 id : range(4096)) {
-    if(armInstruction[id]) continue;
+    if(armTable[id]) continue;
     auto opcode = pattern(".... ???? ???? ---- ---- ---- ???? ----") | id.bit(0,3) << 4 | id.bit(4,11) << 20;
     bind(opcode, Undefined);
   }
@@ -366,10 +381,27 @@ auto ARM7TDMI::armInitialize() -> void {
 }
 
 auto ARM7TDMI::thumbInitialize() -> void {
+  //the operands are packed into thumbOperands and unpacked into their original types
+  //(taken from the bind arguments) when the handler is invoked.
+  u32 handlers = 1;
   #define bind(id, name, ...) { \
-    assert(!thumbInstruction[id]); \
-    thumbInstruction[id] = [=] { return thumbInstruction##name(__VA_ARGS__); }; \
-    thumbDisassemble[id] = [=] { return thumbDisassemble##name(__VA_ARGS__); }; \
+    assert(!thumbTable[id]); \
+    static const u8 handler = [&] { \
+      assert(handlers < 32); \
+      thumbHandlers[handlers] = { \
+        [](ARM7TDMI& self, u16 operands) -> void { \
+          auto arguments = thumbUnpack(operands, (decltype(tuple{__VA_ARGS__})*)nullptr); \
+          return std::apply([&](auto... p) { return self.thumbInstruction##name(p...); }, arguments); \
+        }, \
+        [](ARM7TDMI& self, u16 operands) -> string { \
+          auto arguments = thumbUnpack(operands, (decltype(tuple{__VA_ARGS__})*)nullptr); \
+          return std::apply([&](auto... p) { return self.thumbDisassemble##name(p...); }, arguments); \
+        }, \
+      }; \
+      return handlers++; \
+    }(); \
+    thumbTable[id] = handler; \
+    thumbOperands[id] = thumbPack(__VA_ARGS__); \
   }
 
   #define pattern(s) \
@@ -528,7 +560,7 @@ auto ARM7TDMI::thumbInitialize() -> void {
   }
 
   for(n16 id : range(65536)) {
-    if(thumbInstruction[id]) continue;
+    if(thumbTable[id]) continue;
     auto opcode = pattern("???? ???? ???? ????") | id << 0;
     bind(opcode, Undefined);
   }
@@ -94,7 +94,9 @@ auto M68000::_condition(n4 condition) -> string {
 
 auto M68000::disassembleInstruction(n32 pc) -> string {
   _pc = pc;
-  return {hex(_read<Word>(_pc), 4L), "  ", pad(disassembleTable[_readPC()](), -49)};
+  n16 word = _readPC();
+  auto& opcode = opcodes[word];
+  return {hex(word, 4L), "  ", pad(handlers[opcode.handler].disassemble(*this, opcode.operands), -49)};
 }
 
 auto M68000::disassembleContext() -> string {
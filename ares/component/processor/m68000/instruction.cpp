@@ -1,22 +1,48 @@
+M68000::Opcode M68000::opcodes[65536];
+M68000::Handler M68000::handlers[512];
+u32 M68000::handlerCount = 1;  //handler 0 marks unbound opcodes
+
 auto M68000::instruction() -> void {
   if(!r.stop) {
     r.ird = r.ir;
-    return instructionTable[r.ird]();
+    auto& opcode = opcodes[r.ird];
+    return handlers[opcode.handler].instruction(*this, opcode.operands);
   } else {
      wait(1);
   }
 }
 
 M68000::M68000() {
+  static const bool initialized = (initialize(), true);
+  (void)initialized;
+}
+
+auto M68000::bindHandler(Handler handler) -> u16 {
+  assert(handlerCount < 512);
+  handlers[handlerCount] = handler;
+  return handlerCount++;
+}
+
+auto M68000::initialize() -> void {
+  //each bind site registers one handler per process; the operands are packed into the opcode entry
+  //and unpacked into their original types (taken from the arguments) when the handler is invoked.
   #define bind(id, name, ...) { \
-    assert(!instructionTable[id]); \
-    instructionTable[id] = [=] { return instruction##name(__VA_ARGS__); }; \
-    disassembleTable[id] = [=] { return disassemble##name(__VA_ARGS__); }; \
+    assert(!opcodes[id].handler); \
+    static const u16 handler = bindHandler({ \
+      [](M68000& self, const u16 operands[2]) -> void { \
+        auto arguments = unpack(operands, (decltype(tuple{__VA_ARGS__})*)nullptr); \
+        return std::apply([&](auto... p) { return self.instruction##name(p...); }, arguments); \
+      }, \
+      [](M68000& self, const u16 operands[2]) -> string { \
+        auto arguments = unpack(operands, (decltype(tuple{__VA_ARGS__})*)nullptr); \
+        return std::apply([&](auto... p) { return self.disassemble##name(p...); }, arguments); \
+      }, \
+    }); \
+    opcodes[id] = encode(handler, ##__VA_ARGS__); \
   }
 
   #define unbind(id) { \
-    instructionTable[id].reset(); \
-    disassembleTable[id].reset(); \
+    opcodes[id] = {}; \
   }
 
   #define pattern(s) \
@@ -1276,7 +1302,7 @@ M68000::M68000() {
 
   //ILLEGAL
   for(n16 opcode : range(65536)) {
-    if(instructionTable[opcode]) continue;
+    if(opcodes[opcode].handler) continue;
     bind(opcode, ILLEGAL, opcode);
   }
 
@@ -122,6 +122,7 @@ struct M68000 {
 
   //instruction.cpp
   auto instruction() -> void;
+  static auto initialize() -> void;
 
   //traits.cpp
   template<u32 Size> auto bytes() -> u32;
@@ -298,7 +299,36 @@ struct M68000 {
     bool reset;
   } r;
 
-  function<void ()> instructionTable[65536];
+  //decode tables, built once and shared by every instance.
+  //each opcode selects a handler and carries its pre-decoded operands.
+  struct Opcode {
+    u16 handler;  //index into handlers (0 = unbound)
+    u16 operands[2];
+  };
+  struct Handler {
+    auto (*instruction)(M68000& self, const u16 operands[2]) -> void;
+    auto (*disassemble)(M68000& self, const u16 operands[2]) -> string;
+  };
+  static Opcode opcodes[65536];
+  static Handler handlers[512];
+  static u32 handlerCount;
+
+  static auto bindHandler(Handler handler) -> u16;
+  static auto pack(EffectiveAddress ea) -> u16 { return ea.mode << 3 | ea.reg; }
+  static auto pack(DataRegister dr) -> u16 { return dr.number; }
+  static auto pack(AddressRegister ar) -> u16 { return ar.number; }
+  static auto pack(u16 value) -> u16 { return value; }
+  template<u32 Precision> static auto pack(Natural<Precision> value) -> u16 { static_assert(Precision <= 16); return value; }
+  template<typename... T> static auto encode(u16 handler, const T&... operands) -> Opcode { return {handler, {pack(operands)...}}; }
+  static auto unpack(u16 data, EffectiveAddress*) -> EffectiveAddress { EffectiveAddress ea{0, 0}; ea.mode = data >> 3; ea.reg = data; return ea; }
+  static auto unpack(u16 data, DataRegister*) -> DataRegister { return DataRegister{data}; }
+  static auto unpack(u16 data, AddressRegister*) -> AddressRegister { return AddressRegister{data}; }
+  static auto unpack(u16 data, u16*) -> u16 { return data; }
+  template<u32 Precision> static auto unpack(u16 data, Natural<Precision>*) -> Natural<Precision> { return data; }
+  template<typename... T> static auto unpack(const u16 operands[2], tuple<T...>*) -> tuple<T...> {
+    u32 index = 0;
+    return {unpack(operands[index++], (T*)nullptr)...};
+  }
 
 private:
   //disassembler.cpp
@@ -432,7 +462,6 @@ private:
   auto _condition(n4 condition) -> string;
 
   n32 _pc;
-  function<string ()> disassembleTable[65536];
 };
 
 }
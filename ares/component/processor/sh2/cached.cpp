@@ -1,12 +1,22 @@
+//returns the pool of address without allocating it, or nullptr when it holds no code.
+auto SH2::Recompiler::find(u32 address) const -> Pool* {
+  if(auto table = tables[address >> 20]) return table->pools[address >> 8 & 0xfff];
+  return nullptr;
+}
+
 auto SH2::Recompiler::pool(u32 address) -> Pool* {
-  auto& pool = pools[address >> 8 & 0xffffff];
-  if(!pool) pool = (Pool*)allocator.acquire(sizeof(Pool));
+  auto& table = tables[address >> 20];
+  if(!table) table = new Table{};
+  auto& pool = table->pools[address >> 8 & 0xfff];
+  if(!pool) pool = new Pool{};
   return pool;
 }
 
 auto SH2::Recompiler::block(u32 address) -> Block* {
   if(auto block = pool(address)->blocks[address >> 1 & 0x7f]) return block;
   auto block = emit(address);
+  u32 page = address >> 12 & 0x1ffff;
+  pages[page >> 6] |= 1ull << (page & 63);
   return pool(address)->blocks[address >> 1 & 0x7f] = block;
 }
 
@@ -25,18 +35,118 @@ alwaysinline auto SH2::Recompiler::emitInstruction(u16 opcode) -> bool {
   return 0;
 }
 
+//called by block exits that missed the inline cache: returns the next block to run, or nullptr to return.
+auto SH2::Recompiler::dispatch(Block* source) -> u8* {
+  u32 pc = self.PC;
+  u32 address = pc - 4;  //instruction() runs the block at PC - 4
+  auto pool = find(address);
+  if(!pool) return nullptr;
+  auto block = pool->blocks[address >> 1 & 0x7f];
+  if(!block) return nullptr;
+  link(source, pc, block);
+  return block->code;
+}
+
+//patches the first free cache entry of the exit of source to jump to target when PC is pc.
+auto SH2::Recompiler::link(Block* source, u32 pc, Block* target) -> void {
+  for(auto& link : source->entries) {
+    if(link.target) continue;
+    memory::writel<4>(link.entry + 1, pc);
+    memory::writel<4>(link.entry + 7, u32(target->code - (link.entry + EntrySize)));
+    link.target = target;
+    link.next = target->links;
+    link.prev = &target->links;
+    if(link.next) link.next->prev = &link.next;
+    target->links = &link;
+    return;
+  }
+}
+
+//restores the cache entries that jump to block to their unlinked state.
+auto SH2::Recompiler::unlink(Block* block) -> void {
+  for(auto link = block->links; link; link = link->next) {
+    memory::writel<4>(link->entry + 1, 0);
+    memory::writel<4>(link->entry + 7, 0);
+    link->target = nullptr;
+  }
+  block->links = nullptr;
+}
+
+//removes the cache entries of block from the lists of the blocks they jump to, before its memory is reused.
+auto SH2::Recompiler::detach(Block* block) -> void {
+  for(auto& link : block->entries) {
+    if(!link.target) continue;
+    *link.prev = link.next;
+    if(link.next) link.next->prev = link.prev;
+    link.target = nullptr;
+  }
+}
+
+//drops the pool a store hit, along with its cached or cache-through alias,
+//and forgets the page once no area holds code in it.
+auto SH2::Recompiler::evict(u32 address) -> void {
+  auto drop = [&](u32 address) {
+    auto table = tables[address >> 20];
+    if(!table) return;
+    auto& pool = table->pools[address >> 8 & 0xfff];
+    if(!pool) return;
+    for(auto block : pool->blocks) {
+      if(block) unlink(block);
+    }
+    delete pool;
+    pool = nullptr;
+  };
+  drop(address);
+  if(address >> 29 == Area::Cached || address >> 29 == Area::Uncached) drop(address ^ 0x2000'0000);
+
+  u32 page = address >> 12 & 0x1ffff;
+  for(u32 area : range(8)) {
+    for(u32 index : range(1 << 4)) {
+      if(find(area << 29 | page << 12 | index << 8)) return;
+    }
+  }
+  pages[page >> 6] &= ~(1ull << (page & 63));
+}
+
+//discards every block emitted into a segment of the allocator, so that it can be reused.
+auto SH2::Recompiler::recycle(u32 segment) -> void {
+  for(auto block : segments[segment]) {
+    unlink(block);
+    detach(block);
+    if(auto pool = find(block->address)) {
+      auto& entry = pool->blocks[block->address >> 1 & 0x7f];
+      if(entry == block) entry = nullptr;
+    }
+  }
+  segments[segment].reset();
+  counters.evictions++;
+}
+
+auto SH2::Recompiler::statistics() const -> string {
+  string output;
+  output.append("Translations: ", counters.translations, "\n");
+  output.append("Evictions: ", counters.evictions, "\n");
+  output.append("Bytes: ", counters.bytes, "\n");
+  output.append("Segment: ", allocator.segment() + 1, " of ", Segments, "\n");
+  return output;
+}
+
 auto SH2::Recompiler::emit(u32 address) -> Block* {
-  if(unlikely(allocator.available() < 1_MiB)) {
-    print("SH2 allocator flush\n");
-    allocator.release(bump_allocator::zero_fill);
-    reset();
+  if(unlikely(!dispatcher)) {
+    emitDispatcher();
+    allocator.partition(Segments);
   }
+  if(unlikely(allocator.available() < 1_MiB)) recycle(allocator.advance());
 
   auto block = (Block*)allocator.acquire(sizeof(Block));
   block->code = allocator.acquire();
+  block->address = address;
+  block->links = nullptr;
+  segments[allocator.segment()].append(block);
   bind({block->code, allocator.available()});
 
   bool hasBranched = 0;
+  exits.reset();
   while(true) {
     u16 instruction = self.readWord(address);
     bool branched = emitInstruction(instruction);
@@ -47,12 +157,63 @@ auto SH2::Recompiler::emit(u32 address) -> Block* {
     address += 2;
     if(hasBranched || (address & 0xfe) == 0) break;  //block boundary
     hasBranched = branched;
-    test(rax, rax);
-    jz(imm8(1));
-    ret();
+    test(al, al);
+    jnz(imm32(0));
+    exits.append(size());
   }
-  ret();
+  emitExit(block);
 
   allocator.reserve(size());
+  counters.translations++;
+  counters.bytes += size();
   return block;
 }
+
+//the shared dispatch trampoline: runs the block dispatch() returns, or returns to instruction().
+auto SH2::Recompiler::emitDispatcher() -> void {
+  dispatcher = allocator.acquire();
+  bind({dispatcher, allocator.available()});
+  if constexpr(ABI::SystemV) {
+    sub(rsp, imm8(0x08));
+    mov(rdi, imm64(this));
+  }
+  if constexpr(ABI::Windows) {
+    sub(rsp, imm8(0x28));
+    mov(rcx, imm64(this));
+  }
+  mov(rax, imm64(&Recompiler::dispatch));
+  call(rax);
+  if constexpr(ABI::SystemV) add(rsp, imm8(0x08));
+  if constexpr(ABI::Windows) add(rsp, imm8(0x28));
+  test(rax, rax);
+  jnz(imm8(1));
+  ret();
+  jmp(rax);
+
+  allocator.reserve(size());
+}
+
+//once PC holds the next instruction, keeps running linked blocks for as long as instruction() would.
+auto SH2::Recompiler::emitExit(Block* block) -> void {
+  for(auto label : exits) {
+    memory::writel<4>(amd64::emit.origin.data() + label - 4, size() - label);
+  }
+  exits.reset();
+
+  mov(eax, mem64(&min_cycles));
+  mov(edx, eax);
+  mov(eax, mem64(&self.CCR));
+  cmp(eax, edx);
+  jbe(imm8(1));
+  ret();
+  mov(eax, mem64(&self.PC));
+  for(auto& link : block->entries) {
+    link = {amd64::emit.span.data()};
+    cmp(eax, imm32(0));
+    jz(imm32(0));
+  }
+  assert(amd64::emit.span.data() - block->entries[0].entry == Entries * EntrySize);
+  if constexpr(ABI::SystemV) mov(rsi, imm64(block));
+  if constexpr(ABI::Windows) mov(rdx, imm64(block));
+  jmp(imm32(dispatcher - (amd64::emit.span.data() + 5)));
+}
@@ -249,29 +249,74 @@ struct SH2 {
     SH2& self;
     Recompiler(SH2& self) : self(self) {}
 
+    //blocks exit through an inline cache of {cmp eax,imm32; jz rel32} entries.
+    //each entry is patched to jump straight to the block that followed the exit last time.
+    static constexpr u32 Entries = 2;
+    static constexpr u32 EntrySize = 11;
+    static constexpr u32 Segments = 8;  //the code cache recycles the oldest eighth when it fills up
+
+    struct Block;
+    struct Link {
+      u8* entry;      //the cache entry in the exit of the block that owns this link
+      Block* target;  //the block the entry jumps to, or nullptr while it is unlinked
+      Link* next;     //the other cache entries that jump to target
+      Link** prev;
+    };
+
     struct Block {
       auto execute() -> void {
         ((void (*)())code)();
       }
 
       u8* code;
+      u32 address;
+      Link* links;            //cache entries that jump to this block
+      Link entries[Entries];  //the cache entries of this block's exit
     };
 
     struct Pool {
       Block* blocks[1 << 7];
     };
 
+    //the pools of one 1MiB region of the address space
+    struct Table {
+      Pool* pools[1 << 12];
+    };
+
     auto reset() -> void {
-      for(u32 index : range(1 << 24)) pools[index] = nullptr;
+      for(auto& table : tables) {
+        if(!table) continue;
+        for(auto pool : table->pools) delete pool;
+        delete table;
+        table = nullptr;
+      }
+      for(u32 index : range(1 << 11)) pages[index] = 0;
+      for(auto& blocks : segments) blocks.reset();
+      allocator.release();
+      dispatcher = nullptr;
     }
 
+    //stores only reach evict() when they hit a 4KiB page that contains translated code.
+    //pages are tracked without the area bits, so that cached and cache-through aliases share a bit.
     auto invalidate(u32 address) -> void {
-      pool(address)->blocks[address >> 1 & 0x7f] = nullptr;
+      u32 page = address >> 12 & 0x1ffff;
+      if(likely(!(pages[page >> 6] >> (page & 63) & 1))) return;
+      evict(address);
     }
 
+    auto find(u32 address) const -> Pool*;
     auto pool(u32 address) -> Pool*;
     auto block(u32 address) -> Block*;
+    auto dispatch(Block* source) -> u8*;
+    auto link(Block* source, u32 pc, Block* target) -> void;
+    auto unlink(Block* block) -> void;
+    auto detach(Block* block) -> void;
+    auto evict(u32 address) -> void;
+    auto recycle(u32 segment) -> void;
+    auto statistics() const -> string;
     auto emit(u32 address) -> Block*;
+    auto emitDispatcher() -> void;
+    auto emitExit(Block* block) -> void;
     auto emitInstruction(u16 opcode) -> bool;
 
     template<typename V, typename... P>
@@ -292,9 +337,20 @@ struct SH2 {
       call(rax);
     }
 
+    struct Counters {
+      u64 translations = 0;
+      u64 evictions = 0;  //segments recycled
+      u64 bytes = 0;      //of code emitted
+    };
+
     bump_allocator allocator;
-    Pool* pools[1 << 24];
+    Table* tables[1 << 12];  //allocated on demand: the SH2 only ever runs code from a few regions
+    u64 pages[1 << 11];  //one bit per 4KiB page of the 512MiB external address space
+    vector<Block*> segments[Segments];  //the blocks emitted into each segment of the allocator
+    Counters counters;
     int min_cycles = 0;
+    vector<u32> exits;         //rel32 jumps to the exit of the current block
+    u8* dispatcher = nullptr;  //links a block exit to the next block, or returns to instruction()
   } recompiler{*this};
 
   #include "sh7604/sh7604.hpp"
@@ -183,8 +183,7 @@ auto SH2::writeLong(u32 address, u32 data) -> void {
   }
 
   if constexpr(Accuracy::Recompiler) {
-    recompiler.invalidate(address + 0);
-    recompiler.invalidate(address + 2);
+    recompiler.invalidate(address);
   }
 
   switch(address >> 29) {
@@ -11,6 +11,7 @@ auto PSG::load(Node::Object parent) -> void {
   stream = node->append<Node::Audio::Stream>("PSG");
   stream->setChannels(1);
   stream->setFrequency(system.colorburst() / 16.0);
+  stream->setResampler(Node::Audio::Resampler::Sinc);
   stream->addHighPassFilter(20.0, 1);
 }
 
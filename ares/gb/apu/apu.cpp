@@ -17,6 +17,7 @@ auto APU::load(Node::Object parent) -> void {
   stream = node->append<Node::Audio::Stream>("PSG");
   stream->setChannels(2);
   stream->setFrequency(2 * 1024 * 1024);
+  stream->setResampler(Node::Audio::Resampler::Sinc);
   stream->addHighPassFilter(20.0, 1);
 }
 
@@ -14,6 +14,11 @@ auto M32X::SH7604::Debugger::load(Node::Object parent) -> void {
   tracer.instruction->setAddressBits(32, 1);
 
   tracer.interrupt = parent->append<Node::Debugger::Tracer::Notification>("Interrupt", parent->name());
+
+  if constexpr(SH2::Accuracy::Recompiler) {
+    properties.recompiler = parent->append<Node::Debugger::Properties>(string{parent->name(), " Recompiler"});
+    properties.recompiler->setQuery([&] { return self->recompiler.statistics(); });
+  }
 }
 
 auto M32X::SH7604::Debugger::instruction() -> void {
@@ -31,6 +31,10 @@ struct M32X {
         Node::Debugger::Tracer::Instruction instruction;
         Node::Debugger::Tracer::Notification interrupt;
       } tracer;
+
+      struct Properties {
+        Node::Debugger::Properties recompiler;
+      } properties;
     } debugger;
 
     //sh.cpp
@@ -40,6 +44,7 @@ struct M32X {
     auto main() -> void;
     auto step(u32 clocks) -> void override;
     auto power(bool reset) -> void;
+    auto invalidate(u32 address) -> void;
 
     auto busReadByte(u32 address) -> u32 override;
     auto busReadWord(u32 address) -> u32 override;
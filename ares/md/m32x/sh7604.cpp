@@ -58,6 +58,14 @@ auto M32X::SH7604::power(bool reset) -> void {
   irq.vres.enable = 1;
 }
 
+//both SH2s may run code from SDRAM: stores by either one drop blocks translated by the other.
+auto M32X::SH7604::invalidate(u32 address) -> void {
+  if constexpr(SH2::Accuracy::Recompiler) {
+    m32x.shm.recompiler.invalidate(address);
+    m32x.shs.recompiler.invalidate(address);
+  }
+}
+
 auto M32X::SH7604::busReadByte(u32 address) -> u32 {
   if(address & 1) {
     return m32x.readInternal(0, 1, address & ~1).byte(0);
@@ -77,6 +85,7 @@ auto M32X::SH7604::busReadLong(u32 address) -> u32 {
 
 auto M32X::SH7604::busWriteByte(u32 address, u32 data) -> void {
   debugger.tracer.instruction->invalidate(address & ~1);
+  invalidate(address);
   if(address & 1) {
     m32x.writeInternal(0, 1, address & ~1, data << 8 | (u8)data << 0);
   } else {
@@ -86,12 +95,14 @@ auto M32X::SH7604::busWriteByte(u32 address, u32 data) -> void {
 
 auto M32X::SH7604::busWriteWord(u32 address, u32 data) -> void {
   debugger.tracer.instruction->invalidate(address & ~1);
+  invalidate(address);
   m32x.writeInternal(1, 1, address & ~1, data);
 }
 
 auto M32X::SH7604::busWriteLong(u32 address, u32 data) -> void {
   debugger.tracer.instruction->invalidate(address & ~3 | 0);
   debugger.tracer.instruction->invalidate(address & ~3 | 2);
+  invalidate(address);
   m32x.writeInternal(1, 1, address & ~3 | 0, data >> 16);
   m32x.writeInternal(1, 1, address & ~3 | 2, data >>  0);
 }
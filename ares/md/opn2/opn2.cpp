@@ -11,6 +11,7 @@ auto OPN2::load(Node::Object parent) -> void {
   stream = node->append<Node::Audio::Stream>("YM2612");
   stream->setChannels(2);
   stream->setFrequency(system.frequency() / 7.0 / 144.0);
+  stream->setResampler(Node::Audio::Resampler::Sinc);
   stream->addHighPassFilter(  20.0, 1);
   stream->addLowPassFilter (2840.0, 1);
 }
@@ -4,6 +4,7 @@ auto VDP::PSG::load(Node::Object parent) -> void {
   stream = node->append<Node::Audio::Stream>("PSG");
   stream->setChannels(1);
   stream->setFrequency(system.frequency() / 15.0 / 16.0);
+  stream->setResampler(Node::Audio::Resampler::Sinc);
   stream->addHighPassFilter(  20.0, 1);
   stream->addLowPassFilter (2840.0, 1);
 }
@@ -43,6 +43,13 @@ auto Cartridge::connect() -> void {
     flash.load(fp);
   }
 
+  if constexpr(Accuracy::CPU::Recompiler) {
+    if(auto fp = pak->read("recompiler.cache")) {
+      auto rom = pak->read("program.rom");
+      cpu.recompiler.load(fp, rom ? Hash::SHA256({rom->data(), rom->size()}).output() : vector<u8>{});
+    }
+  }
+
   isviewer.ram.allocate(64_KiB);
 
   debugger.load(node);
@@ -77,6 +84,12 @@ auto Cartridge::save() -> void {
   if(auto fp = pak->write("save.flash")) {
     flash.save(fp);
   }
+
+  if constexpr(Accuracy::CPU::Recompiler) {
+    if(auto fp = pak->write("recompiler.cache")) {
+      cpu.recompiler.save(fp);
+    }
+  }
 }
 
 auto Cartridge::power(bool reset) -> void {
@@ -24,6 +24,10 @@ auto CPU::load(Node::Object parent) -> void {
 }
 
 auto CPU::unload() -> void {
+  if constexpr(Accuracy::CPU::Recompiler) {
+    recompiler.report();
+    recompiler.unload();
+  }
   debugger.unload();
   node.reset();
 }
@@ -43,11 +47,15 @@ auto CPU::synchronize() -> void {
 
    vi.clock -= clocks;
    ai.clock -= clocks;
-  rsp.clock -= clocks;
   rdp.clock -= clocks;
   while( vi.clock < 0)  vi.main();
   while( ai.clock < 0)  ai.main();
-  while(rsp.clock < 0) rsp.main();
+  if(rsp.worker.active) {
+    rsp.worker.advance(clocks);
+  } else {
+    rsp.clock -= clocks;
+    while(rsp.clock < 0) rsp.main();
+  }
   while(rdp.clock < 0) rdp.main();
 
   queue.step(clocks, [](u32 event) {
@@ -77,9 +85,12 @@ auto CPU::instruction() -> void {
   }
 
   if constexpr(Accuracy::CPU::Recompiler) {
-    auto address = devirtualize(ipu.pc)(0);
-    auto block = recompiler.block(address);
-    block->execute();
+    if(auto address = devirtualize(ipu.pc)) {
+      auto block = recompiler.block(*address);
+      recompiler.execute(block);
+    } else {
+      step(1);  //the fetch raised an exception: resume at its vector
+    }
   }
 
   if constexpr(Accuracy::CPU::Interpreter) {
@@ -113,6 +124,32 @@ auto CPU::instructionEpilogue() -> bool {
   unreachable;
 }
 
+//performs the epilogues of straight-line instructions that the recompiler emitted inline.
+//these never branch or raise exceptions, so only the program counter and timers advance.
+auto CPU::instructionRetire(u32 instructions) -> void {
+  if(!instructions) return;
+
+  //only the first fetch from each instruction cache line can miss
+  u32 address = ipu.pc;
+  for(u32 remaining = instructions; remaining;) {
+    u32 fetches = min(remaining, 8 - (address >> 2 & 7));
+    icache.step(address);
+    step(2 * (fetches - 1));
+    address += fetches * 4;
+    remaining -= fetches;
+  }
+  ipu.pc += instructions * 4;
+
+  //random counts down from 31 to wired, and restarts at 31 when it falls below it
+  u32 wired = scc.wired.index;
+  u32 period = 32 - wired;
+  if(scc.random.index < wired) {
+    scc.random.index = 31;
+    instructions--;
+  }
+  scc.random.index = wired + (scc.random.index - wired + period - instructions % period) % period;
+}
+
 auto CPU::power(bool reset) -> void {
   Thread::reset();
 
@@ -126,6 +163,7 @@ auto CPU::power(bool reset) -> void {
   dcache.power(reset);
   for(auto& entry : tlb.entry) entry = {};
   tlb.physicalAddress = 0;
+  tlb.flush();
   for(auto& r : ipu.r) r.u64 = 0;
   ipu.lo.u64 = 0;
   ipu.hi.u64 = 0;
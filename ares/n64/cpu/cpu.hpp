@@ -24,7 +24,12 @@ struct CPU : Thread {
       Node::Debugger::Tracer::Notification exception;
       Node::Debugger::Tracer::Notification interrupt;
       Node::Debugger::Tracer::Notification tlb;
+      Node::Debugger::Tracer::Notification recompiler;
     } tracer;
+
+    struct Properties {
+      Node::Debugger::Properties recompiler;
+    } properties;
   } debugger;
 
   //cpu.cpp
@@ -37,6 +42,7 @@ struct CPU : Thread {
 
   auto instruction() -> void;
   auto instructionEpilogue() -> bool;
+  auto instructionRetire(u32 instructions) -> void;
 
   auto power(bool reset) -> void;
 
@@ -167,6 +173,9 @@ struct CPU : Thread {
     //tlb.cpp
     auto load(u32 address) -> Match;
     auto store(u32 address) -> Match;
+    auto cached(u32 address) -> maybe<u32>;
+    auto fill(u32 address, u32 physicalAddress, bool cache, bool dirty) -> void;
+    auto flush() -> void;
     auto exception(u32 address) -> void;
 
     struct Entry {
@@ -190,7 +199,18 @@ struct CPU : Thread {
       n40 addressCompare;
     } entry[TLB::Entries];
 
+    //a direct-mapped cache of recent 4KiB page translations, searched before the entries.
+    //flush() discards it whenever the entries or the current address space ID may have changed.
+    struct Line {
+      u32 page;
+      u32 generation;
+      u32 physicalAddress;
+      bool cache;
+      bool dirty;
+    } lines[256];
+
     u32 physicalAddress;
+    u32 generation = 1;  //lines from older generations are stale
   } tlb{*this};
 
   //memory.cpp
@@ -689,30 +709,88 @@ struct CPU : Thread {
     CPU& self;
     Recompiler(CPU& self) : self(self) {}
 
-    struct Block {
-      auto execute() -> void {
-        ((void (*)())code)();
-      }
+    //blocks exit through an inline cache of {cmp eax,imm32; jz rel32} entries.
+    //each entry is patched to jump straight to the block that followed the exit last time.
+    static constexpr u32 Entries = 2;
+    static constexpr u32 EntrySize = 11;
+    static constexpr s64 Budget = 512;  //clocks linked blocks may run before returning to the scheduler
+    static constexpr u32 Segments = 8;  //the code cache recycles the oldest eighth when it fills up
+
+    struct Block;
+    struct Link {
+      u8* entry;      //the cache entry in the exit of the block that owns this link
+      Block* target;  //the block the entry jumps to, or nullptr while it is unlinked
+      Link* next;     //the other cache entries that jump to target
+      Link** prev;
+    };
 
+    struct Block {
       u8* code;
+      u32 address;
+      Link* links;             //cache entries that jump to this block
+      Link entries[Entries];   //the cache entries of this block's exit
     };
 
     struct Pool {
       Block* blocks[1 << 6];
     };
 
+    //the RDRAM blocks a run translated, so that later runs can translate them as soon as their code is loaded.
+    struct Profile {
+      u32 address;
+      u32 checksum;  //of the instructions from address to the end of its pool
+    };
+
     auto reset() -> void {
-      for(u32 index : range(1 << 21)) pools[index] = nullptr;
+      for(u32 index : range(1 << 21)) delete pools[index], pools[index] = nullptr;
+      for(u32 index : range(1 << 11)) pages[index] = 0;
+      for(auto& blocks : segments) blocks.reset();
+      allocator.release();
+      enter = nullptr;
     }
 
+    //stores only reach evict() when they hit a 4KiB page that contains translated code.
     auto invalidate(u32 address) -> void {
-      pools[address >> 8 & 0x1fffff] = nullptr;
+      u32 page = address >> 12 & 0x1ffff;
+      if(likely(!(pages[page >> 6] >> (page & 63) & 1))) return;
+      evict(address);
+    }
+
+    auto invalidate(u32 address, u32 length) -> void;
+
+    auto execute(Block* block) -> void {
+      ((void (*)(u8*))enter)(block->code);
     }
 
     auto pool(u32 address) -> Pool*;
     auto block(u32 address) -> Block*;
+    auto dispatch(Block* source) -> u8*;
+    auto link(Block* source, u32 pc, Block* target) -> void;
+    auto unlink(Block* block) -> void;
+    auto detach(Block* block) -> void;
+    auto evict(u32 address) -> void;
+    auto recycle(u32 segment) -> void;
+    auto statistics() const -> string;
+    auto checksum(u32 address) -> u32;
+    auto preload(u32 address, u32 length) -> void;
+    auto load(VFS::File fp, array_view<u8> key) -> void;
+    auto save(VFS::File fp) -> void;
+    auto unload() -> void;
 
     auto emit(u32 address) -> Block*;
+    auto emitStubs() -> void;
+    auto emitExit(Block* block) -> void;
+    auto emitReturn() -> void;
+    auto emitRetire(u32 instructions) -> void;
+    auto emitRequire64() -> void;
+    template<u32 Size, bool Store, typename... P> auto emitAccess(u32 instruction, auto (CPU::*function)(P...) -> void) -> void;
+    auto emitBranch(s16 offset, u32 label, bool likely) -> void;
+    auto emitJump() -> void;
+    auto emitLink(dis8 target) -> void;
+    auto resolve(u32 label) -> void;
+    auto tally(u32 instruction, bool inlined) -> void;
+    auto report() -> void;
+
     auto emitEXECUTE(u32 instruction) -> bool;
     auto emitSPECIAL(u32 instruction) -> bool;
     auto emitREGIMM(u32 instruction) -> bool;
@@ -721,8 +799,33 @@ struct CPU : Thread {
 
     template<typename R, typename... P> auto call(R (CPU::*function)(P...)) -> void;
 
+    struct Coverage {
+      u64 inlined = 0;
+      u64 interpreted = 0;
+    };
+
+    struct Counters {
+      u64 translations = 0;
+      u64 evictions = 0;  //segments recycled
+      u64 bytes = 0;      //of code emitted
+    };
+
     bump_allocator allocator;
     Pool* pools[1 << 21];  //2_MiB * sizeof(void*) == 16_MiB
+    vector<Block*> segments[Segments];  //the blocks emitted into each segment of the allocator
+    Counters counters;
+    u64 pages[1 << 11];     //one bit per 4KiB page of the 512MiB physical address space
+    u32 pending = 0;        //inline instructions whose epilogues have not been emitted yet
+    bool interpreted = 0;   //the current instruction calls into the interpreter
+    vector<u32> exits;      //rel32 jumps to the exit of the current block
+    u8* enter = nullptr;    //saves host registers and jumps to the block passed as the first argument
+    u8* leave = nullptr;    //restores host registers and returns from enter
+    u8* dispatcher = nullptr;
+    map<string, Coverage> coverage;  //per-opcode translation counts (recompiler tracer only)
+    vector<u8> key;                  //ROM SHA-256 and emulator version the profile is valid for
+    vector<Profile> profile;         //blocks translated by this run, in translation order
+    vector<Profile> preloads;        //blocks translated by earlier runs, sorted by address
+    bool profiling = false;
   } recompiler{*this};
 
   struct Disassembler {
@@ -5,6 +5,12 @@ auto CPU::Debugger::load(Node::Object parent) -> void {
   tracer.exception = parent->append<Node::Debugger::Tracer::Notification>("Exception", "CPU");
   tracer.interrupt = parent->append<Node::Debugger::Tracer::Notification>("Interrupt", "CPU");
   tracer.tlb = parent->append<Node::Debugger::Tracer::Notification>("TLB", "CPU");
+  tracer.recompiler = parent->append<Node::Debugger::Tracer::Notification>("Recompiler", "CPU");
+
+  if constexpr(Accuracy::CPU::Recompiler) {
+    properties.recompiler = parent->append<Node::Debugger::Properties>("CPU Recompiler");
+    properties.recompiler->setQuery([&] { return cpu.recompiler.statistics(); });
+  }
 }
 
 auto CPU::Debugger::unload() -> void {
@@ -12,6 +18,8 @@ auto CPU::Debugger::unload() -> void {
   tracer.exception.reset();
   tracer.interrupt.reset();
   tracer.tlb.reset();
+  tracer.recompiler.reset();
+  properties.recompiler.reset();
 }
 
 auto CPU::Debugger::instruction() -> void {
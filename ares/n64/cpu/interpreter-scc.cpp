@@ -177,6 +177,7 @@ auto CPU::setControlRegister(n5 index, n64 data) -> void {
     scc.count = data.bit(0,31) << 1;
     break;
   case 10:  //entryhi
+    if(scc.tlb.addressSpaceID != data.bit(0,7)) tlb.flush();
     scc.tlb.addressSpaceID            = data.bit( 0, 7);
     scc.tlb.virtualAddress.bit(13,39) = data.bit(13,39);
     scc.tlb.region                    = data.bit(62,63);
@@ -341,6 +342,7 @@ auto CPU::TLBR() -> void {
   }
   if(scc.index.tlbEntry >= TLB::Entries) return;
   scc.tlb = tlb.entry[scc.index.tlbEntry];
+  tlb.flush();  //the address space ID may have changed
 }
 
 auto CPU::TLBWI() -> void {
@@ -349,6 +351,7 @@ auto CPU::TLBWI() -> void {
   }
   if(scc.index.tlbEntry >= TLB::Entries) return;
   tlb.entry[scc.index.tlbEntry] = scc.tlb;
+  tlb.flush();
   debugger.tlbWrite(scc.index.tlbEntry);
 }
 
@@ -358,5 +361,6 @@ auto CPU::TLBWR() -> void {
   }
   if(scc.random.index >= TLB::Entries) return;
   tlb.entry[scc.random.index] = scc.tlb;
+  tlb.flush();
   debugger.tlbWrite(scc.random.index);
 }
@@ -1,41 +1,256 @@
 auto CPU::Recompiler::pool(u32 address) -> Pool* {
   auto& pool = pools[address >> 8 & 0x1fffff];
-  if(!pool) pool = (Pool*)allocator.acquire(sizeof(Pool));
+  if(!pool) pool = new Pool{};
   return pool;
 }
 
 auto CPU::Recompiler::block(u32 address) -> Block* {
   if(auto block = pool(address)->blocks[address >> 2 & 0x3f]) return block;
+  if(unlikely(profiling) && (address & 0x1fff'ffff) <= 0x007f'ffff) {
+    profile.append({address & 0x1fff'ffff, checksum(address)});
+  }
   auto block = emit(address);
+  u32 page = address >> 12 & 0x1ffff;
+  pages[page >> 6] |= 1ull << (page & 63);
   return pool(address)->blocks[address >> 2 & 0x3f] = block;
 }
 
+//called by block exits that missed the inline cache: returns the next block to run, or nullptr to leave.
+//only the direct-mapped kernel segments are linked, so that TLB changes never need to unlink blocks.
+//TLB-mapped code is found through the translation cache instead, and re-checked on every exit.
+auto CPU::Recompiler::dispatch(Block* source) -> u8* {
+  if(self.scc.cause.interruptPending & self.scc.status.interruptMask) {
+    if(self.scc.status.interruptEnable && !self.scc.status.exceptionLevel && !self.scc.status.errorLevel) return nullptr;
+  }
+  u32 pc = self.ipu.pc;
+  u32 address = pc;
+  bool direct = pc >> 30 == 2;  //KSEG0 or KSEG1
+  if(!direct) {
+    if(self.context.segment[pc >> 29 & 7] != Context::Segment::Mapped) return nullptr;
+    if(auto match = self.tlb.cached(pc)) address = *match; else return nullptr;
+  }
+  auto pool = pools[address >> 8 & 0x1fffff];
+  if(!pool) return nullptr;
+  auto block = pool->blocks[address >> 2 & 0x3f];
+  if(!block) return nullptr;
+  if(direct) link(source, pc, block);
+  return block->code;
+}
+
+//patches the first free cache entry of the exit of source to jump to target when the program counter is pc.
+auto CPU::Recompiler::link(Block* source, u32 pc, Block* target) -> void {
+  for(auto& link : source->entries) {
+    if(link.target) continue;
+    memory::writel<4>(link.entry + 1, pc);
+    memory::writel<4>(link.entry + 7, u32(target->code - (link.entry + EntrySize)));
+    link.target = target;
+    link.next = target->links;
+    link.prev = &target->links;
+    if(link.next) link.next->prev = &link.next;
+    target->links = &link;
+    return;
+  }
+}
+
+//restores the cache entries that jump to block to their unlinked state.
+auto CPU::Recompiler::unlink(Block* block) -> void {
+  for(auto link = block->links; link; link = link->next) {
+    memory::writel<4>(link->entry + 1, 0);
+    memory::writel<4>(link->entry + 7, 0);
+    link->target = nullptr;
+  }
+  block->links = nullptr;
+}
+
+//removes the cache entries of block from the lists of the blocks they jump to, before its memory is reused.
+auto CPU::Recompiler::detach(Block* block) -> void {
+  for(auto& link : block->entries) {
+    if(!link.target) continue;
+    *link.prev = link.next;
+    if(link.next) link.next->prev = link.prev;
+    link.target = nullptr;
+  }
+}
+
+//drops the pool a store hit, and forgets the page once none of its pools hold code.
+//the blocks stay in their segment until it is recycled, as other exits may still refer to them.
+auto CPU::Recompiler::evict(u32 address) -> void {
+  if(auto& pool = pools[address >> 8 & 0x1fffff]) {
+    for(auto block : pool->blocks) {
+      if(block) unlink(block);
+    }
+    delete pool;
+    pool = nullptr;
+  }
+  u32 page = address >> 12 & 0x1ffff;
+  for(u32 index : range(1 << 4)) {
+    if(pools[page << 4 | index]) return;
+  }
+  pages[page >> 6] &= ~(1ull << (page & 63));
+}
+
+//invalidates [address, address + length) as if by one store per pool, skipping pages that hold no code.
+auto CPU::Recompiler::invalidate(u32 address, u32 length) -> void {
+  u32 end = address + length;
+  for(u32 pool = address & ~0xff; pool < end;) {
+    u32 page = pool >> 12 & 0x1ffff;
+    if(!(pages[page >> 6] >> (page & 63) & 1)) {
+      pool = (pool | 0xfff) + 1;
+      continue;
+    }
+    evict(pool);
+    pool += 0x100;
+  }
+}
+
+//discards every block emitted into a segment of the allocator, so that it can be reused.
+auto CPU::Recompiler::recycle(u32 segment) -> void {
+  for(auto block : segments[segment]) {
+    unlink(block);
+    detach(block);
+    if(auto pool = pools[block->address >> 8 & 0x1fffff]) {
+      auto& entry = pool->blocks[block->address >> 2 & 0x3f];
+      if(entry == block) entry = nullptr;
+    }
+  }
+  segments[segment].reset();
+  counters.evictions++;
+}
+
+auto CPU::Recompiler::statistics() const -> string {
+  string output;
+  output.append("Translations: ", counters.translations, "\n");
+  output.append("Evictions: ", counters.evictions, "\n");
+  output.append("Bytes: ", counters.bytes, "\n");
+  output.append("Segment: ", allocator.segment() + 1, " of ", Segments, "\n");
+  return output;
+}
+
+auto CPU::Recompiler::checksum(u32 address) -> u32 {
+  u32 hash = 0;
+  do {
+    hash = (hash << 5) + hash + bus.read<Word>(address);
+    address += 4;
+  } while(address & 0xfc);
+  return hash;
+}
+
+//translates the profiled blocks in [address, address + length) whose code is unchanged since they were profiled.
+//called once DMA transfers have finished loading code into RDRAM.
+auto CPU::Recompiler::preload(u32 address, u32 length) -> void {
+  if(!preloads) return;
+  address &= 0x1fff'ffff;
+  u32 lo = 0, hi = preloads.size();
+  while(lo < hi) {
+    u32 mid = lo + hi >> 1;
+    if(preloads[mid].address < address) lo = mid + 1; else hi = mid;
+  }
+  for(; lo < preloads.size() && preloads[lo].address < address + length; lo++) {
+    auto& entry = preloads[lo];
+    if(pool(entry.address)->blocks[entry.address >> 2 & 0x3f]) continue;
+    if(checksum(entry.address) != entry.checksum) continue;
+    block(entry.address);
+  }
+}
+
+//the profile holds a 32-byte ROM SHA-256, a 16-byte version string, an entry count and the entries.
+//a profile saved by another ROM or emulator version is discarded.
+auto CPU::Recompiler::load(VFS::File fp, array_view<u8> key) -> void {
+  unload();
+  for(u32 n : range(32)) this->key.append(n < key.size() ? key[n] : 0);
+  for(u32 n : range(16)) this->key.append(n < ares::Version.size() ? ares::Version[n] : 0);
+  profiling = true;
+
+  fp->seek(0);
+  for(u32 n : range(48)) {
+    if(fp->read() != this->key[n]) return;
+  }
+  u32 count = min(fp->readl(4), (fp->size() - 52) / 8);
+  for(u32 n : range(count)) {
+    Profile entry;
+    entry.address = fp->readl(4);
+    entry.checksum = fp->readl(4);
+    preloads.append(entry);
+  }
+  preloads.sort([](auto& lhs, auto& rhs) { return lhs.address < rhs.address; });
+}
+
+//keeps the blocks of this run first, then those of earlier runs, for as many entries as the file holds.
+auto CPU::Recompiler::save(VFS::File fp) -> void {
+  if(!profiling || fp->size() < 52) return;
+  u32 capacity = (fp->size() - 52) / 8;
+  vector<Profile> entries;
+  set<u64> seen;
+  for(auto& list : {&profile, &preloads}) {
+    for(auto& entry : *list) {
+      if(entries.size() >= capacity) break;
+      if(seen.insert((u64)entry.address << 32 | entry.checksum)) entries.append(entry);
+    }
+  }
+
+  fp->seek(0);
+  fp->write(key);
+  fp->writel(entries.size(), 4);
+  for(auto& entry : entries) {
+    fp->writel(entry.address, 4);
+    fp->writel(entry.checksum, 4);
+  }
+}
+
+auto CPU::Recompiler::unload() -> void {
+  key.reset();
+  profile.reset();
+  preloads.reset();
+  profiling = false;
+}
+
 auto CPU::Recompiler::emit(u32 address) -> Block* {
-  if(unlikely(allocator.available() < 1_MiB)) {
-    print("CPU allocator flush\n");
-    allocator.release(bump_allocator::zero_fill);
-    reset();
+  if(unlikely(!enter)) {
+    emitStubs();
+    allocator.partition(Segments);
   }
+  if(unlikely(allocator.available() < 1_MiB)) recycle(allocator.advance());
 
   auto block = (Block*)allocator.acquire(sizeof(Block));
   block->code = allocator.acquire();
+  block->address = address;
+  block->links = nullptr;
+  segments[allocator.segment()].append(block);
   bind({block->code, allocator.available()});
-  push(rbx);
-  push(rbp);
-  push(r13);
-  if constexpr(ABI::Windows) {
-    push(rsi);
-    push(rdi);
-    sub(rsp, imm8(0x40));
-  }
-  mov(rbx, imm64(&self.ipu.r[0] + 16));
-  mov(rbp, imm64(&self));
-  mov(r13, imm64(&self.fpu.r[0] + 16));
 
   bool hasBranched = 0;
+  bool first = 1;
+  pending = 0;
+  exits.reset();
   while(true) {
     u32 instruction = bus.read<Word>(address);
+    auto checkpoint = amd64::emit.span;
+    interpreted = 0;
     bool branched = emitEXECUTE(instruction);
+    bool inlined = !interpreted && !branched;
+    if(!inlined && pending) {
+      //the instruction may observe the program counter or raise an exception:
+      //retire the inline instructions before it, then translate it again.
+      amd64::emit.span = checkpoint;
+      emitRetire(pending);
+      pending = 0;
+      interpreted = 0;
+      branched = emitEXECUTE(instruction);
+    }
+    if(unlikely(self.debugger.tracer.recompiler->enabled())) tally(instruction, inlined);
+
+    //inline instructions defer their epilogues, except where the pipeline may be in a delay slot.
+    if(inlined && !hasBranched && !first) {
+      if((instruction >> 16 & 31) == 0 || (instruction >> 11 & 31) == 0) {
+        xor(eax, eax);
+        mov(dis8(rbx, -128), rax);  //r0
+      }
+      pending++;
+      address += 4;
+      if((address & 0xfc) == 0) break;  //block boundary
+      continue;
+    }
+
     if(unlikely(instruction == 0x1000'ffff)) {
       //accelerate idle loops
       mov(rax, mem64(&self.clock));
@@ -44,20 +259,90 @@ auto CPU::Recompiler::emit(u32 address) -> Block* {
     }
     call(&CPU::instructionEpilogue);
     address += 4;
+    first = 0;
     if(hasBranched || (address & 0xfc) == 0) break;  //block boundary
     hasBranched = branched;
-    test(rax, rax);
-    jz(imm8(ABI::Windows ? 11 : 5));
-    if constexpr(ABI::Windows) {
-      add(rsp, imm8(0x40));
-      pop(rdi);
-      pop(rsi);
-    }
-    pop(r13);
-    pop(rbp);
-    pop(rbx);
-    ret();
+    test(al, al);
+    jnz(imm32(0));
+    exits.append(size());
   }
+  emitRetire(pending);
+  emitExit(block);
+
+  allocator.reserve(size());
+  counters.translations++;
+  counters.bytes += size();
+//print(hex(PC, 8L), " ", instructions, " ", size(), "\n");
+  return block;
+}
+
+//the shared entry, exit and dispatch trampolines.
+auto CPU::Recompiler::emitStubs() -> void {
+  enter = allocator.acquire();
+  bind({enter, allocator.available()});
+  push(rbx);
+  push(rbp);
+  push(r13);
+  if constexpr(ABI::Windows) {
+    push(rsi);
+    push(rdi);
+    sub(rsp, imm8(0x40));
+  }
+  mov(rbx, imm64(&self.ipu.r[0] + 16));
+  mov(rbp, imm64(&self));
+  mov(r13, imm64(&self.fpu.r[0] + 16));
+  if constexpr(ABI::SystemV) jmp(rdi);
+  if constexpr(ABI::Windows) jmp(rcx);
+
+  leave = amd64::emit.span.data();
+  emitReturn();
+
+  dispatcher = amd64::emit.span.data();
+  mov(rax, imm64(&Recompiler::dispatch));
+  if constexpr(ABI::SystemV) mov(rdi, imm64(this));
+  if constexpr(ABI::Windows) mov(rcx, imm64(this));
+  call(rax);
+  test(rax, rax);
+  jz(imm32(leave - (amd64::emit.span.data() + 6)));
+  jmp(rax);
+
+  allocator.reserve(size());
+}
+
+//leaves the block once ipu.pc holds the next instruction to execute.
+//linked blocks keep running until the clock budget expires, the CPU leaves kernel mode or an interrupt is due.
+auto CPU::Recompiler::emitExit(Block* block) -> void {
+  for(auto label : exits) {
+    memory::writel<4>(amd64::emit.origin.data() + label - 4, size() - label);
+  }
+  exits.reset();
+
+  mov(rax, mem64(&self.clock));
+  cmp(rax, imm32(Budget));
+  jge(imm32(leave - (amd64::emit.span.data() + 6)));
+  mov(eax, mem64(&self.context.mode));
+  test(eax, eax);  //Context::Mode::Kernel
+  jnz(imm32(leave - (amd64::emit.span.data() + 6)));
+  mov(al, mem64(&self.scc.status.interruptMask));
+  mov(dl, al);
+  mov(al, mem64(&self.scc.cause.interruptPending));
+  test(al, dl);
+  jnz(imm32(0));  //let dispatch() decide whether the interrupt is taken
+  auto interrupt = size();
+  mov(eax, mem64(&self.ipu.pc));  //segments are selected by the low 32 bits
+  for(auto& link : block->entries) {
+    link = {amd64::emit.span.data()};
+    cmp(eax, imm32(0));
+    jz(imm32(0));
+  }
+  assert(amd64::emit.span.data() - block->entries[0].entry == Entries * EntrySize);
+  memory::writel<4>(amd64::emit.origin.data() + interrupt - 4, size() - interrupt);
+  if constexpr(ABI::SystemV) mov(rsi, imm64(block));
+  if constexpr(ABI::Windows) mov(rdx, imm64(block));
+  jmp(imm32(dispatcher - (amd64::emit.span.data() + 5)));
+}
+
+auto CPU::Recompiler::emitReturn() -> void {
   if constexpr(ABI::Windows) {
     add(rsp, imm8(0x40));
     pop(rdi);
@@ -67,10 +352,101 @@ auto CPU::Recompiler::emit(u32 address) -> Block* {
   pop(rbp);
   pop(rbx);
   ret();
+}
 
-  allocator.reserve(size());
-//print(hex(PC, 8L), " ", instructions, " ", size(), "\n");
-  return block;
+//runs the deferred epilogues of inline instructions.
+auto CPU::Recompiler::emitRetire(u32 instructions) -> void {
+  if(!instructions) return;
+  mov(esi, imm32(instructions));
+  call(&CPU::instructionRetire);
+}
+
+//64-bit operations are reserved instructions in 32-bit user and supervisor modes.
+//the slow path retires the preceding inline instructions, raises the exception and leaves the block.
+auto CPU::Recompiler::emitRequire64() -> void {
+  bool interpreted = this->interpreted;
+  mov(eax, mem64(&self.context.mode));
+  test(eax, eax);  //Context::Mode::Kernel
+  jz(imm8(0));
+  auto kernel = size();
+  mov(eax, mem64(&self.context.bits));
+  cmp(eax, imm8(32));
+  jnz(imm8(0));
+  auto bits64 = size();
+  emitRetire(pending);
+  call(&CPU::INVALID);
+  call(&CPU::instructionEpilogue);
+  jmp(imm32(0));
+  exits.append(size());
+  resolve(kernel);
+  resolve(bits64);
+  this->interpreted = interpreted;
+}
+
+//points the rel8 displacement of the jump ending at label to the current position.
+auto CPU::Recompiler::resolve(u32 label) -> void {
+  u32 distance = size() - label;
+  assert(distance < 0x80);
+  amd64::emit.origin.data()[label - 1] = distance;
+}
+
+//branch.take(PC + 4 + (offset << 2)), preceded by a conditional jump ending at label that skips it.
+//likely branches discard their delay slot when not taken.
+auto CPU::Recompiler::emitBranch(s16 offset, u32 label, bool likely) -> void {
+  mov(rax, mem64(&self.ipu.pc));
+  add(eax, imm32(4 + (offset << 2)));
+  emitJump();
+  if(likely) {
+    jmp(imm8(0));
+    auto taken = size();
+    resolve(label);
+    mov(eax, imm32(Branch::Discard));
+    mov(mem64(&self.branch.state), eax);
+    resolve(taken);
+  } else {
+    resolve(label);
+  }
+}
+
+//branch.take(eax)
+auto CPU::Recompiler::emitJump() -> void {
+  mov(mem64(&self.branch.pc), rax);  //32-bit operations zero the upper half of rax
+  mov(eax, imm32(Branch::Take));
+  mov(mem64(&self.branch.state), eax);
+}
+
+//target = s32(PC + 8)
+auto CPU::Recompiler::emitLink(dis8 target) -> void {
+  mov(rax, mem64(&self.ipu.pc));
+  add(eax, imm32(8));
+  movsxd(rax, eax);
+  mov(target, rax);
+}
+
+auto CPU::Recompiler::tally(u32 instruction, bool inlined) -> void {
+  self.disassembler.showColors = 0;
+  self.disassembler.showValues = 0;
+  auto name = self.disassembler.disassemble(0, instruction).split(" ", 1L).first();
+  self.disassembler.showColors = 1;
+  self.disassembler.showValues = 1;
+  if(!coverage.find(name)) coverage.insert(name, {});
+  auto& counts = coverage.find(name)();
+  if(inlined) counts.inlined++;
+  else counts.interpreted++;
+}
+
+//logs how often each opcode was translated to native code, and how often it still calls the interpreter.
+auto CPU::Recompiler::report() -> void {
+  if(!coverage.size()) return;
+  struct Entry { string name; Coverage counts; };
+  vector<Entry> entries;
+  for(auto& node : coverage) entries.append({node.key, node.value});
+  entries.sort([](auto& x, auto& y) { return x.counts.interpreted > y.counts.interpreted; });
+  for(auto& entry : entries) {
+    auto& counts = entry.counts;
+    self.debugger.tracer.recompiler->notify({pad(entry.name, -8L), " inline ", counts.inlined, " interpreted ", counts.interpreted});
+  }
+  coverage.reset();
 }
 
 #define Sa  (instruction >>  6 & 31)
@@ -90,6 +466,103 @@ auto CPU::Recompiler::emit(u32 address) -> Block* {
 #define n16 u16(instruction)
 #define n26 u32(instruction & 0x03ff'ffff)
 
+//addresses the data of an aligned load or store through the kernel segments, and steps its clock.
+//KSEG0 accesses that hit the data cache, and KSEG1 accesses to RDRAM, leave rdx + rcx pointing at the data.
+//every other access (misaligned, TLB-mapped, a cache miss or I/O) takes a slow path that retires the
+//preceding inline instructions, calls the interpreter and its epilogue, and leaves the block.
+template<u32 Size, bool Store, typename... P>
+auto CPU::Recompiler::emitAccess(u32 instruction, auto (CPU::*function)(P...) -> void) -> void {
+  bool cop1 = (instruction >> 26) == 0x31 || (instruction >> 26) == 0x39;  //LWC1, SWC1
+  bool interpreted = this->interpreted;
+  jmp(imm8(0));
+  auto fast = size();
+  auto slow = size();
+  emitRetire(pending);
+  if(cop1) mov(esi, imm32(Ftn));
+  if(!cop1) lea(rsi, Rt);
+  lea(rdx, Rs);
+  mov(ecx, imm32(i16));
+  call(function);
+  call(&CPU::instructionEpilogue);
+  jmp(imm32(0));
+  exits.append(size());
+  resolve(fast);
+  this->interpreted = interpreted;
+
+  mov(eax, mem64(&self.context.mode));
+  test(eax, eax);  //Context::Mode::Kernel
+  jnz(imm32(slow - (size() + 6)));
+  if(cop1) {
+    mov(al, mem64(&self.scc.status.enable.coprocessor1));
+    test(al, al);
+    jz(imm32(slow - (size() + 6)));
+    if(Ftn & 1) {
+      //odd registers name the upper half of the even register pair when FR=0
+      mov(al, mem64(&self.scc.status.floatingPointMode));
+      test(al, al);
+      jz(imm32(slow - (size() + 6)));
+    }
+  }
+  mov(esi, Rs);
+  add(esi, imm32(i16));
+  if constexpr(Size != Byte) {
+    mov(eax, esi);
+    and(eax, imm8(Size - 1));
+    jnz(imm32(slow - (size() + 6)));
+  }
+  mov(eax, esi);
+  shr(eax, imm8(29));
+  cmp(eax, imm8(4));  //KSEG0
+  jnz(imm8(0));
+  auto direct = size();
+
+  auto& line = self.dcache.lines[0];
+  auto offset = [&](auto& field) -> s8 { return (u8*)&field - (u8*)&line; };
+  mov(ecx, esi);
+  shr(ecx, imm8(4));
+  and(ecx, imm32(0x1ff));
+  imul(ecx, ecx, imm32(sizeof(line)));
+  mov(rdx, imm64(&line));
+  add(rdx, rcx);
+  mov(al, dis8(rdx, offset(line.valid)));
+  test(al, al);
+  jz(imm32(slow - (size() + 6)));
+  mov(eax, esi);
+  and(eax, imm32(~0xfff));
+  cmp(eax, dis8(rdx, offset(line.tag)));
+  jnz(imm32(slow - (size() + 6)));
+  if constexpr(Store) movb(dis8(rdx, offset(line.dirty)), imm8(1));
+  add(rdx, imm8(offset(line.bytes)));
+  mov(ecx, esi);
+  and(ecx, imm8(16 - Size));
+  jmp(imm8(0));
+  auto cached = size();
+
+  resolve(direct);
+  cmp(eax, imm8(5));  //KSEG1
+  jnz(imm32(slow - (size() + 6)));
+  mov(ecx, esi);
+  and(ecx, imm32(0x1fff'ffff));
+  cmp(ecx, imm32(min(rdram.ram.size, 0x80'0000)));
+  jae(imm32(slow - (size() + 6)));
+  if constexpr(Store) {
+    //stores to pages holding translated code invalidate it through the bus
+    mov(edx, ecx);
+    shr(edx, imm8(12));
+    mov(rax, imm64(&pages[0]));
+    bt(dis(rax), rdx);
+    jb(imm32(slow - (size() + 6)));
+  }
+  mov(rdx, imm64(rdram.ram.data));
+
+  resolve(cached);
+  if constexpr(Size == Byte) xor(ecx, imm8(3));
+  if constexpr(Size == Half) xor(ecx, imm8(2));
+  mov(rax, mem64(&self.clock));
+  add(rax, imm8(1));
+  mov(mem64(&self.clock), rax);
+}
+
 auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
   switch(instruction >> 26) {
 
@@ -105,49 +578,58 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //J n26
   case 0x02: {
-    mov(esi, imm32(n26));
-    call(&CPU::J);
+    mov(rax, mem64(&self.ipu.pc));
+    add(eax, imm32(4));
+    and(eax, imm32(0xf000'0000));
+    or(eax, imm32(n26 << 2));
+    emitJump();
     return 1;
   }
 
   //JAL n26
   case 0x03: {
-    mov(esi, imm32(n26));
-    call(&CPU::JAL);
+    emitLink(dis8(rbx, (31 - 16) * 8));
+    mov(rax, mem64(&self.ipu.pc));
+    add(eax, imm32(4));
+    and(eax, imm32(0xf000'0000));
+    or(eax, imm32(n26 << 2));
+    emitJump();
     return 1;
   }
 
   //BEQ Rs,Rt,i16
   case 0x04: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    mov(ecx, imm32(i16));
-    call(&CPU::BEQ);
+    mov(rax, Rs);
+    cmp(rax, Rt);
+    jnz(imm8(0));
+    emitBranch(i16, size(), 0);
     return 1;
   }
 
   //BNE Rs,Rt,i16
   case 0x05: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    mov(ecx, imm32(i16));
-    call(&CPU::BNE);
+    mov(rax, Rs);
+    cmp(rax, Rt);
+    jz(imm8(0));
+    emitBranch(i16, size(), 0);
     return 1;
   }
 
   //BLEZ Rs,i16
   case 0x06: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BLEZ);
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jg(imm8(0));
+    emitBranch(i16, size(), 0);
     return 1;
   }
 
   //BGTZ Rs,i16
   case 0x07: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BGTZ);
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jle(imm8(0));
+    emitBranch(i16, size(), 0);
     return 1;
   }
 
@@ -249,35 +731,37 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //BEQL Rs,Rt,i16
   case 0x14: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    mov(ecx, imm32(i16));
-    call(&CPU::BEQL);
+    mov(rax, Rs);
+    cmp(rax, Rt);
+    jnz(imm8(0));
+    emitBranch(i16, size(), 1);
     return 1;
   }
 
   //BNEL Rs,Rt,i16
   case 0x15: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    mov(ecx, imm32(i16));
-    call(&CPU::BNEL);
+    mov(rax, Rs);
+    cmp(rax, Rt);
+    jz(imm8(0));
+    emitBranch(i16, size(), 1);
     return 1;
   }
 
   //BLEZL Rs,i16
   case 0x16: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BLEZL);
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jg(imm8(0));
+    emitBranch(i16, size(), 1);
     return 1;
   }
 
   //BGTZL Rs,i16
   case 0x17: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BGTZL);
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jle(imm8(0));
+    emitBranch(i16, size(), 1);
     return 1;
   }
 
@@ -292,10 +776,10 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //DADDIU Rt,Rs,i16
   case 0x19: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::DADDIU);
+    emitRequire64();
+    mov(rsi, Rs);
+    add(rsi, imm32(i16));
+    mov(Rt, rsi);
     return 0;
   }
 
@@ -325,19 +809,19 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LB Rt,Rs,i16
   case 0x20: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LB);
+    emitAccess<Byte, 0>(instruction, &CPU::LB);
+    movsxb(eax, idx(rdx, rcx));
+    movsxd(rax, eax);
+    mov(Rt, rax);
     return 0;
   }
 
   //LH Rt,Rs,i16
   case 0x21: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LH);
+    emitAccess<Half, 0>(instruction, &CPU::LH);
+    movsxw(eax, idx(rdx, rcx));
+    movsxd(rax, eax);
+    mov(Rt, rax);
     return 0;
   }
 
@@ -352,28 +836,26 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LW Rt,Rs,i16
   case 0x23: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LW);
+    emitAccess<Word, 0>(instruction, &CPU::LW);
+    mov(eax, idx(rdx, rcx));
+    movsxd(rax, eax);
+    mov(Rt, rax);
     return 0;
   }
 
   //LBU Rt,Rs,i16
   case 0x24: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LBU);
+    emitAccess<Byte, 0>(instruction, &CPU::LBU);
+    movzxb(eax, idx(rdx, rcx));
+    mov(Rt, rax);
     return 0;
   }
 
   //LHU Rt,Rs,i16
   case 0x25: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LHU);
+    emitAccess<Half, 0>(instruction, &CPU::LHU);
+    movzxw(eax, idx(rdx, rcx));
+    mov(Rt, rax);
     return 0;
   }
 
@@ -388,28 +870,25 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LWU Rt,Rs,i16
   case 0x27: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LWU);
+    emitAccess<Word, 0>(instruction, &CPU::LWU);
+    mov(eax, idx(rdx, rcx));
+    mov(Rt, rax);
     return 0;
   }
 
   //SB Rt,Rs,i16
   case 0x28: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SB);
+    emitAccess<Byte, 1>(instruction, &CPU::SB);
+    mov(al, Rt);
+    mov(idx(rdx, rcx), al);
     return 0;
   }
 
   //SH Rt,Rs,i16
   case 0x29: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SH);
+    emitAccess<Half, 1>(instruction, &CPU::SH);
+    mov(eax, Rt);
+    mov(idx(rdx, rcx), ax);
     return 0;
   }
 
@@ -424,10 +903,9 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //SW Rt,Rs,i16
   case 0x2b: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SW);
+    emitAccess<Word, 1>(instruction, &CPU::SW);
+    mov(eax, Rt);
+    mov(idx(rdx, rcx), eax);
     return 0;
   }
 
@@ -478,10 +956,9 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LWC1 Ft,Rs,i16
   case 0x31: {
-    mov(esi, imm32(Ftn));
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LWC1);
+    emitAccess<Word, 0>(instruction, &CPU::LWC1);
+    mov(eax, idx(rdx, rcx));
+    mov(Ft, eax);
     return 0;
   }
 
@@ -523,10 +1000,13 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LD Rt,Rs,i16
   case 0x37: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LD);
+    emitAccess<Dual, 0>(instruction, &CPU::LD);
+    mov(eax, idx(rdx, rcx));
+    add(rdx, imm8(4));
+    mov(esi, idx(rdx, rcx));
+    shl(rax, imm8(32));
+    or(rax, rsi);
+    mov(Rt, rax);
     return 0;
   }
 
@@ -541,10 +1021,9 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //SWC1 Ft,Rs,i16
   case 0x39: {
-    mov(esi, imm32(Ftn));
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SWC1);
+    emitAccess<Word, 1>(instruction, &CPU::SWC1);
+    mov(eax, Ft);
+    mov(idx(rdx, rcx), eax);
     return 0;
   }
 
@@ -586,10 +1065,12 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //SD Rt,Rs,i16
   case 0x3f: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SD);
+    emitAccess<Dual, 1>(instruction, &CPU::SD);
+    mov(eax, dis8(rbx, (Rtn - 16) * 8 + 4));
+    mov(idx(rdx, rcx), eax);
+    add(rdx, imm8(4));
+    mov(eax, Rt);
+    mov(idx(rdx, rcx), eax);
     return 0;
   }
 
@@ -675,16 +1156,16 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //JR Rs
   case 0x08: {
-    lea(rsi, Rs);
-    call(&CPU::JR);
+    mov(eax, Rs);
+    emitJump();
     return 1;
   }
 
   //JALR Rd,Rs
   case 0x09: {
-    lea(rsi, Rd);
-    lea(rdx, Rs);
-    call(&CPU::JALR);
+    emitLink(Rd);
+    mov(eax, Rs);
+    emitJump();
     return 1;
   }
 
@@ -748,10 +1229,12 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSLLV Rd,Rt,Rs
   case 0x14: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    lea(rcx, Rs);
-    call(&CPU::DSLLV);
+    emitRequire64();
+    mov(rsi, Rt);
+    mov(cl, Rs);
+    and(cl, imm8(63));
+    shl(rsi, cl);
+    mov(Rd, rsi);
     return 0;
   }
 
@@ -763,35 +1246,49 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSRLV Rd,Rt,Rs
   case 0x16: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    lea(rcx, Rs);
-    call(&CPU::DSRLV);
+    emitRequire64();
+    mov(rsi, Rt);
+    mov(cl, Rs);
+    and(cl, imm8(63));
+    shr(rsi, cl);
+    mov(Rd, rsi);
     return 0;
   }
 
   //DSRAV Rd,Rt,Rs
   case 0x17: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    lea(rcx, Rs);
-    call(&CPU::DSRAV);
+    emitRequire64();
+    mov(rsi, Rt);
+    mov(cl, Rs);
+    and(cl, imm8(63));
+    sar(rsi, cl);
+    mov(Rd, rsi);
     return 0;
   }
 
   //MULT Rs,Rt
   case 0x18: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    call(&CPU::MULT);
+    mov(eax, Rs);
+    mov(ecx, Rt);
+    imul(ecx);
+    movsxd(rax, eax);
+    movsxd(rdx, edx);
+    mov(mem64(&self.ipu.lo), rax);
+    mov(rax, rdx);
+    mov(mem64(&self.ipu.hi), rax);
     return 0;
   }
 
   //MULTU Rs,Rt
   case 0x19: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    call(&CPU::MULTU);
+    mov(eax, Rs);
+    mov(ecx, Rt);
+    mul(ecx);
+    movsxd(rax, eax);
+    movsxd(rdx, edx);
+    mov(mem64(&self.ipu.lo), rax);
+    mov(rax, rdx);
+    mov(mem64(&self.ipu.hi), rax);
     return 0;
   }
 
@@ -813,17 +1310,25 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DMULT Rs,Rt
   case 0x1c: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    call(&CPU::DMULT);
+    emitRequire64();
+    mov(rax, Rs);
+    mov(rcx, Rt);
+    imul(rcx);
+    mov(mem64(&self.ipu.lo), rax);
+    mov(rax, rdx);
+    mov(mem64(&self.ipu.hi), rax);
     return 0;
   }
 
   //DMULTU Rs,Rt
   case 0x1d: {
-    lea(rsi, Rs);
-    lea(rdx, Rt);
-    call(&CPU::DMULTU);
+    emitRequire64();
+    mov(rax, Rs);
+    mov(rcx, Rt);
+    mul(rcx);
+    mov(mem64(&self.ipu.lo), rax);
+    mov(rax, rdx);
+    mov(mem64(&self.ipu.hi), rax);
     return 0;
   }
 
@@ -949,10 +1454,10 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DADDU Rd,Rs,Rt
   case 0x2d: {
-    lea(rsi, Rd);
-    lea(rdx, Rs);
-    lea(rcx, Rt);
-    call(&CPU::DADDU);
+    emitRequire64();
+    mov(rsi, Rs);
+    add(rsi, Rt);
+    mov(Rd, rsi);
     return 0;
   }
 
@@ -967,10 +1472,10 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSUBU Rd,Rs,Rt
   case 0x2f: {
-    lea(rsi, Rd);
-    lea(rdx, Rs);
-    lea(rcx, Rt);
-    call(&CPU::DSUBU);
+    emitRequire64();
+    mov(rsi, Rs);
+    sub(rsi, Rt);
+    mov(Rd, rsi);
     return 0;
   }
 
@@ -1036,10 +1541,10 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSLL Rd,Rt,Sa
   case 0x38: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    mov(ecx, imm32(Sa));
-    call(&CPU::DSLL);
+    emitRequire64();
+    mov(rsi, Rt);
+    shl(rsi, imm8(Sa));
+    mov(Rd, rsi);
     return 0;
   }
 
@@ -1051,28 +1556,28 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSRL Rd,Rt,Sa
   case 0x3a: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    mov(ecx, imm32(Sa));
-    call(&CPU::DSRL);
+    emitRequire64();
+    mov(rsi, Rt);
+    shr(rsi, imm8(Sa));
+    mov(Rd, rsi);
     return 0;
   }
 
   //DSRA Rd,Rt,Sa
   case 0x3b: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    mov(ecx, imm32(Sa));
-    call(&CPU::DSRA);
+    emitRequire64();
+    mov(rsi, Rt);
+    sar(rsi, imm8(Sa));
+    mov(Rd, rsi);
     return 0;
   }
 
   //DSLL32 Rd,Rt,Sa
   case 0x3c: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    mov(ecx, imm32(Sa+32));
-    call(&CPU::DSLL);
+    emitRequire64();
+    mov(rsi, Rt);
+    shl(rsi, imm8(Sa+32));
+    mov(Rd, rsi);
     return 0;
   }
 
@@ -1084,19 +1589,19 @@ auto CPU::Recompiler::emitSPECIAL(u32 instruction) -> bool {
 
   //DSRL32 Rd,Rt,Sa
   case 0x3e: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    mov(ecx, imm32(Sa+32));
-    call(&CPU::DSRL);
+    emitRequire64();
+    mov(rsi, Rt);
+    shr(rsi, imm8(Sa+32));
+    mov(Rd, rsi);
     return 0;
   }
 
   //DSRA32 Rd,Rt,Sa
   case 0x3f: {
-    lea(rsi, Rd);
-    lea(rdx, Rt);
-    mov(ecx, imm32(Sa+32));
-    call(&CPU::DSRA);
+    emitRequire64();
+    mov(rsi, Rt);
+    sar(rsi, imm8(Sa+32));
+    mov(Rd, rsi);
     return 0;
   }
 
@@ -1110,34 +1615,38 @@ auto CPU::Recompiler::emitREGIMM(u32 instruction) -> bool {
 
   //BLTZ Rs,i16
   case 0x00: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BLTZ);
-    return 0;
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jge(imm8(0));
+    emitBranch(i16, size(), 0);
+    return 1;
   }
 
   //BGEZ Rs,i16
   case 0x01: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BGEZ);
-    return 0;
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jl(imm8(0));
+    emitBranch(i16, size(), 0);
+    return 1;
   }
 
   //BLTZL Rs,i16
   case 0x02: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BLTZL);
-    return 0;
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jge(imm8(0));
+    emitBranch(i16, size(), 1);
+    return 1;
   }
 
   //BGEZL Rs,i16
   case 0x03: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BGEZL);
-    return 0;
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jl(imm8(0));
+    emitBranch(i16, size(), 1);
+    return 1;
   }
 
   //INVALID
@@ -1208,34 +1717,42 @@ auto CPU::Recompiler::emitREGIMM(u32 instruction) -> bool {
 
   //BLTZAL Rs,i16
   case 0x10: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BLTZAL);
-    return 0;
+    emitLink(dis8(rbx, (31 - 16) * 8));
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jge(imm8(0));
+    emitBranch(i16, size(), 0);
+    return 1;
   }
 
   //BGEZAL Rs,i16
   case 0x11: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BGEZAL);
-    return 0;
+    emitLink(dis8(rbx, (31 - 16) * 8));
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jl(imm8(0));
+    emitBranch(i16, size(), 0);
+    return 1;
   }
 
   //BLTZALL Rs,i16
   case 0x12: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BLTZALL);
-    return 0;
+    emitLink(dis8(rbx, (31 - 16) * 8));
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jge(imm8(0));
+    emitBranch(i16, size(), 1);
+    return 1;
   }
 
   //BGEZALL Rs,i16
   case 0x13: {
-    lea(rsi, Rs);
-    mov(edx, imm32(i16));
-    call(&CPU::BGEZALL);
-    return 0;
+    emitLink(dis8(rbx, (31 - 16) * 8));
+    mov(rax, Rs);
+    cmp(rax, imm8(0));
+    jl(imm8(0));
+    emitBranch(i16, size(), 1);
+    return 1;
   }
 
   //INVALID
@@ -2058,6 +2575,7 @@ auto CPU::Recompiler::emitFPU(u32 instruction) -> bool {
 template<typename V, typename... P>
 auto CPU::Recompiler::call(V (CPU::*function)(P...)) -> void {
   static_assert(sizeof...(P) <= 5);
+  interpreted = 1;
   mov(rax, imm64(function));
   if constexpr(ABI::SystemV) {
     mov(rdi, rbp);
@@ -44,6 +44,7 @@ auto CPU::serialize(serializer& s) -> void {
     s(e.addressCompare);
   }
   s(tlb.physicalAddress);
+  tlb.flush();
 
   for(auto& r : ipu.r) s(r.u64);
   s(ipu.lo.u64);
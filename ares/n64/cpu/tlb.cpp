@@ -1,6 +1,13 @@
 //the N64 TLB is 32-bit only: only the 64-bit XTLB exception vector is used.
 
 auto CPU::TLB::load(u32 address) -> Match {
+  auto& line = lines[address >> 12 & 255];
+  if(line.page == address >> 12 && line.generation == generation) {
+    physicalAddress = line.physicalAddress + (address & 0xfff);
+    self.debugger.tlbLoad(address, physicalAddress);
+    return {true, line.cache, physicalAddress};
+  }
+
   for(auto& entry : this->entry) {
     if(!entry.globals || entry.addressSpaceID != self.scc.tlb.addressSpaceID) continue;
     if((address & entry.addressMaskHi) != (u32)entry.addressCompare) continue;
@@ -12,6 +19,7 @@ auto CPU::TLB::load(u32 address) -> Match {
       return {false};
     }
     physicalAddress = entry.physicalAddress[lo] + (address & entry.addressMaskLo);
+    fill(address, physicalAddress, entry.cacheAlgorithm[lo] != 2, entry.dirty[lo]);
     self.debugger.tlbLoad(address, physicalAddress);
     return {true, entry.cacheAlgorithm[lo] != 2, physicalAddress};
   }
@@ -22,6 +30,13 @@ auto CPU::TLB::load(u32 address) -> Match {
 }
 
 auto CPU::TLB::store(u32 address) -> Match {
+  auto& line = lines[address >> 12 & 255];
+  if(line.page == address >> 12 && line.generation == generation && line.dirty) {
+    physicalAddress = line.physicalAddress + (address & 0xfff);
+    self.debugger.tlbStore(address, physicalAddress);
+    return {true, line.cache, physicalAddress};
+  }
+
   for(auto& entry : this->entry) {
     if(!entry.globals || entry.addressSpaceID != self.scc.tlb.addressSpaceID) continue;
     if((address & entry.addressMaskHi) != (u32)entry.addressCompare) continue;
@@ -39,6 +54,7 @@ auto CPU::TLB::store(u32 address) -> Match {
       return {false};
     }
     physicalAddress = entry.physicalAddress[lo] + (address & entry.addressMaskLo);
+    fill(address, physicalAddress, entry.cacheAlgorithm[lo] != 2, 1);
     self.debugger.tlbStore(address, physicalAddress);
     return {true, entry.cacheAlgorithm[lo] != 2, physicalAddress};
   }
@@ -48,6 +64,30 @@ auto CPU::TLB::store(u32 address) -> Match {
   return {false};
 }
 
+//returns the physical address of a previously translated page without raising exceptions.
+auto CPU::TLB::cached(u32 address) -> maybe<u32> {
+  auto& line = lines[address >> 12 & 255];
+  if(line.page == address >> 12 && line.generation == generation) {
+    return line.physicalAddress + (address & 0xfff);
+  }
+  return nothing;
+}
+
+auto CPU::TLB::fill(u32 address, u32 physicalAddress, bool cache, bool dirty) -> void {
+  auto& line = lines[address >> 12 & 255];
+  line.page = address >> 12;
+  line.generation = generation;
+  line.physicalAddress = physicalAddress - (address & 0xfff);
+  line.cache = cache;
+  line.dirty = dirty;
+}
+
+auto CPU::TLB::flush() -> void {
+  if(++generation) return;
+  for(auto& line : lines) line = {};
+  generation = 1;
+}
+
 auto CPU::TLB::exception(u32 address) -> void {
   self.scc.badVirtualAddress = address;
   self.scc.tlb.virtualAddress.bit(13,39) = address >> 13;
@@ -6,6 +6,7 @@ inline auto Bus::read(u32 address) -> u64 {
   if(address <= 0x007f'ffff) return rdram.ram.read<Size>(address);
   if(address <= 0x03ef'ffff) return unmapped;
   if(address <= 0x03ff'ffff) return rdram.read<Size>(address);
+  if(address <= 0x042f'ffff) rsp.worker.synchronize();  //the RSP may be running on another thread
   if(address <= 0x0400'0fff) return rsp.dmem.read<Size>(address);
   if(address <= 0x0400'1fff) return rsp.imem.read<Size>(address);
   if(address <= 0x0403'ffff) return unmapped;
@@ -49,12 +50,12 @@ inline auto Bus::read(u32 address) -> u64 {
 template<u32 Size>
 inline auto Bus::write(u32 address, u64 data) -> void {
   address &= 0x1fff'ffff - (Size - 1);
-  cpu.recompiler.invalidate(address + 0); if constexpr(Size == Dual)
-  cpu.recompiler.invalidate(address + 4);
+  cpu.recompiler.invalidate(address);  //aligned stores never cross a 256-byte pool
 
   if(address <= 0x007f'ffff) return rdram.ram.write<Size>(address, data);
   if(address <= 0x03ef'ffff) return;
   if(address <= 0x03ff'ffff) return rdram.write<Size>(address, data);
+  if(address <= 0x042f'ffff) rsp.worker.synchronize();  //the RSP may be running on another thread
   if(address <= 0x0400'0fff) return rsp.dmem.write<Size>(address, data);
   if(address <= 0x0400'1fff) return rsp.recompiler.invalidate(), rsp.imem.write<Size>(address, data);
   if(address <= 0x0403'ffff) return;
@@ -94,3 +95,57 @@ inline auto Bus::write(u32 address, u64 data) -> void {
   if(address <= 0x1fc0'07ff) return pi.ram.write<Size>(address, data);
   return;
 }
+
+//performs a DMA transfer of length bytes in units of Size bytes.
+//spans between memories share the same word-swapped byte order, so they are copied wholesale,
+//and any translated code they overwrite is invalidated once per span rather than once per unit.
+template<u32 Size>
+inline auto Bus::copy(u32 target, u32 source, u32 length) -> void {
+  while(length) {
+    auto from = span(source, 0);
+    auto to = span(target, 1);
+    u32 bytes = Size;
+    if(from && to) {
+      u32 span = min(length, min(from.length, to.length));
+      if(((source | target) & 3) == 0 && span >= 4) {
+        span &= ~3;
+        memory::copy(to.data + (target & to.mask), from.data + (source & from.mask), span);
+        cpu.recompiler.invalidate(target & 0x1fff'ffff, span);
+        if((target & 0x1fff'f000) == 0x0400'1000) rsp.recompiler.invalidate();
+        target += span, source += span, length -= span;
+        continue;
+      }
+      if((source ^ target) & 3) bytes = max(span & ~(Size - 1), Size);
+    }
+    for(u32 offset = 0; offset < bytes; offset += Size) {
+      write<Size>(target + offset, read<Size>(source + offset));
+    }
+    if(bytes >= length) break;
+    target += bytes, source += bytes, length -= bytes;
+  }
+}
+
+inline auto Bus::span(u32 address, bool write) -> Span {
+  address &= 0x1fff'ffff;
+  auto map = [&](auto& memory, u32 end) -> Span {
+    u32 mask = memory.maskByte;
+    return {memory.data, mask, min(end - address, mask + 1 - (address & mask))};
+  };
+
+  if(address <= 0x007f'ffff) return map(rdram.ram, 0x0080'0000);
+  if(address <= 0x03ff'ffff) return {};
+  if(address <= 0x0400'1fff) rsp.worker.synchronize();
+  if(address <= 0x0400'0fff) return map(rsp.dmem, 0x0400'1000);
+  if(address <= 0x0400'1fff) return map(rsp.imem, 0x0400'2000);
+  if(address <= 0x07ff'ffff) return {};
+  if(address <= 0x0fff'ffff) {
+    if(cartridge.ram) return map(cartridge.ram, 0x1000'0000);
+    return {};
+  }
+  if(address <= 0x13fe'ffff) return write ? Span{} : map(cartridge.rom, 0x13ff'0000);
+  if(address <= 0x13ff'ffff) return {};  //ISViewer
+  if(address <= 0x1fbf'ffff) return write ? Span{} : map(cartridge.rom, 0x1fc0'0000);
+  if(address <= 0x1fc0'07bf) return {};
+  if(address <= 0x1fc0'07ff) return map(pi.ram, 0x1fc0'0800);
+  return {};
+}
@@ -26,20 +26,34 @@ struct Writable {
   }
 
   auto fill(u32 value = 0) -> void {
-    for(u32 address = 0; address < size; address += 4) {
-      *(u32*)&data[address & maskWord] = value;
-    }
+    auto words = (u32*)data;
+    for(u32 index = 0; index < size >> 2; index++) words[index] = value;
   }
 
   auto load(VFS::File fp) -> void {
     if(!size) allocate(fp->size());
-    for(u32 address = 0; address < min(size, fp->size()); address += 4) {
+    u32 length = min(size, fp->size());
+    u32 address = 0;
+    if(auto source = fp->data()) {
+      //convert the file contents in place of reading them a byte at a time
+      address = min<u64>(length, fp->size() - min(fp->size(), fp->offset())) & ~3;
+      swap(data, source + fp->offset(), address);
+      fp->seek(fp->offset() + address);
+    }
+    for(; address < length; address += 4) {
       *(u32*)&data[address & maskWord] = fp->readm(4L);
     }
   }
 
   auto save(VFS::File fp) -> void {
-    for(u32 address = 0; address < min(size, fp->size()); address += 4) {
+    u32 length = min(size, fp->size());
+    u32 address = 0;
+    if(auto target = fp->data()) {
+      address = min<u64>(length, fp->size() - min(fp->size(), fp->offset())) & ~3;
+      swap(target + fp->offset(), data, address);
+      fp->seek(fp->offset() + address);
+    }
+    for(; address < length; address += 4) {
       fp->writem(*(u32*)&data[address & maskWord], 4L);
     }
   }
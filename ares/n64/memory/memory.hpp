@@ -1,13 +1,43 @@
 namespace Memory {
+  //converts whole words between the big-endian byte order of files and the host order of memory.
+  //the conversion is its own inverse, so it serves both load() and save().
+  inline auto swap(u8* target, const u8* source, u32 size) -> void {
+    u32 address = 0;
+    #if defined(__SSSE3__)
+    const __m128i shuffle = _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    for(; address + 16 <= size; address += 16) {
+      auto words = _mm_loadu_si128((const __m128i*)(source + address));
+      _mm_storeu_si128((__m128i*)(target + address), _mm_shuffle_epi8(words, shuffle));
+    }
+    #endif
+    for(; address + 4 <= size; address += 4) {
+      u32 word;
+      memcpy(&word, source + address, 4);
+      word = bswap32(word);
+      memcpy(target + address, &word, 4);
+    }
+  }
+
   #include "lsb/readable.hpp"
   #include "lsb/writable.hpp"
   #include "io.hpp"
 }
 
 struct Bus {
+  //memory that DMA transfers may access directly rather than through read() and write()
+  struct Span {
+    explicit operator bool() const { return data; }
+
+    u8* data = nullptr;
+    u32 mask = 0;
+    u32 length = 0;  //bytes until the end of the region, or until the memory mirrors
+  };
+
   //bus.hpp
   template<u32 Size> auto read(u32 address) -> u64;
   template<u32 Size> auto write(u32 address, u64 data) -> void;
+  template<u32 Size> auto copy(u32 target, u32 source, u32 length) -> void;
+  auto span(u32 address, bool write) -> Span;
 };
 
 extern Bus bus;
@@ -3,6 +3,7 @@
 
 #include <ares/ares.hpp>
 #include <nall/hashset.hpp>
+#include <nall/map.hpp>
 #include <nall/recompiler/amd64/amd64.hpp>
 #include <component/processor/sm5k/sm5k.hpp>
 
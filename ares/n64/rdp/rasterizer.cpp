@@ -0,0 +1,568 @@
+//9-bit shade values wrap from 0x100-0x17f (overflow) to 0x180-0x1ff (underflow)
+static auto clamp9(s32 value) -> s32 {
+  value &= 0x1ff;
+  if(value & 0x100) return value & 0x80 ? 0 : 255;
+  return value;
+}
+
+static auto expand5(u32 value) -> s32 {
+  value &= 31;
+  return value << 3 | value >> 2;
+}
+
+//the depth buffer stores 18-bit depths as a 3-bit exponent (the count of leading ones) and an 11-bit mantissa
+static auto zCompress(u32 z) -> u16 {
+  u32 exponent = 0;
+  while(exponent < 7 && z >> 17 - exponent & 1) exponent++;
+  u32 shift = exponent < 6 ? 6 - exponent : 0;
+  return exponent << 11 | z >> shift & 0x7ff;
+}
+
+static auto zDecompress(u16 z) -> u32 {
+  static constexpr u32 shift[8] = {6, 5, 4, 3, 2, 1, 0, 0};
+  static constexpr u32 base[8] = {0x00000, 0x20000, 0x30000, 0x38000, 0x3c000, 0x3e000, 0x3f000, 0x3f800};
+  u32 exponent = z >> 11 & 7;
+  return base[exponent] + ((z & 0x7ff) << shift[exponent]);
+}
+
+auto RDP::Rasterizer::triangle(bool shaded, bool textured, bool zbuffered) -> void {
+  Primitive primitive;
+  primitive.type = Primitive::Type::Triangle;
+  primitive.shaded = shaded;
+  primitive.textured = textured;
+  primitive.zbuffered = zbuffered;
+  primitive.flipped = false;
+  primitive.state = snapshot();
+  primitive.edge = self.edge;
+  if(shaded) primitive.shade = self.shade;
+  if(textured) primitive.texture = self.texture;
+  if(zbuffered) primitive.zbuffer = self.zbuffer;
+  batch.append(primitive);
+}
+
+auto RDP::Rasterizer::rectangle(bool textured, bool flipped) -> void {
+  Primitive primitive;
+  primitive.type = Primitive::Type::Rectangle;
+  primitive.shaded = false;
+  primitive.textured = textured;
+  primitive.zbuffered = false;
+  primitive.flipped = flipped;
+  primitive.state = snapshot();
+  if(textured) {
+    primitive.rectangle = self.rectangle;
+  } else {
+    primitive.rectangle.x.lo = self.fillRectangle_.x.lo;
+    primitive.rectangle.x.hi = self.fillRectangle_.x.hi;
+    primitive.rectangle.y.lo = self.fillRectangle_.y.lo;
+    primitive.rectangle.y.hi = self.fillRectangle_.y.hi;
+  }
+  batch.append(primitive);
+}
+
+//draws every queued primitive. this must happen before TMEM or the target images change,
+//and before anything else can observe RDRAM.
+auto RDP::Rasterizer::flush() -> void {
+  if(!batch) return;
+
+  if(!threads) {
+    threads = min(thread::concurrency(), Threads);
+    for(u32 index : range(1, threads)) {
+      handles[index] = thread::create({&RDP::Rasterizer::main, this}, index);
+    }
+  }
+
+  if(threads == 1 || batch.size() < Batch) {
+    for(auto& primitive : batch) draw(primitive, 0, 1);
+  } else {
+    {
+      lock_guard<mutex> guard{lock};
+      for(u32 index : range(1, threads)) pending[index] = true;
+      remaining = threads - 1;
+      wake.notify_all();
+    }
+    for(auto& primitive : batch) draw(primitive, 0, threads);
+    unique_lock<mutex> guard{lock};
+    done.wait(guard, [&] { return remaining == 0; });
+  }
+  batch.reset();
+}
+
+auto RDP::Rasterizer::main(uintptr_t index) -> void {
+  unique_lock<mutex> guard{lock};
+  while(true) {
+    wake.wait(guard, [&] { return quit || pending[index]; });
+    if(quit) break;
+    guard.unlock();
+    for(auto& primitive : batch) draw(primitive, index, threads);
+    guard.lock();
+    pending[index] = false;
+    if(--remaining == 0) done.notify_all();
+  }
+}
+
+auto RDP::Rasterizer::kill() -> void {
+  if(threads > 1) {
+    {
+      lock_guard<mutex> guard{lock};
+      quit = true;
+      wake.notify_all();
+    }
+    for(u32 index : range(1, threads)) handles[index].join();
+    quit = false;
+  }
+  threads = 0;
+}
+
+auto RDP::Rasterizer::power() -> void {
+  kill();
+  batch.reset();
+}
+
+auto RDP::Rasterizer::snapshot() const -> State {
+  State state;
+  state.other = self.other;
+  state.combine = self.combine;
+  state.fog = self.fog;
+  state.blend = self.blend;
+  state.primitive = self.primitive;
+  state.environment = self.environment;
+  state.primitiveDepth = self.primitiveDepth;
+  state.scissor = self.scissor;
+  state.convert = self.convert;
+  state.set = self.set;
+  for(u32 index : range(8)) state.tiles[index] = self.tiles[index];
+  return state;
+}
+
+//draws the scanlines of a primitive that belong to thread index of count.
+auto RDP::Rasterizer::draw(const Primitive& primitive, u32 index, u32 count) -> void {
+  if(primitive.type == Primitive::Type::Triangle) return drawTriangle(primitive, index, count);
+  if(primitive.type == Primitive::Type::Rectangle) return drawRectangle(primitive, index, count);
+}
+
+auto RDP::Rasterizer::drawTriangle(const Primitive& primitive, u32 index, u32 count) -> void {
+  auto& state = primitive.state;
+  auto& edge = primitive.edge;
+  auto fixed = [](const Point& point) -> s64 { return s32(u32(point.i) << 16 | u32(point.f)); };
+
+  struct Attribute {
+    s64 c;  //value where the major edge crosses the first scanline
+    s64 x;  //change per pixel
+    s64 e;  //change per scanline along the major edge
+  };
+  auto attribute = [&](const Point& c, const Point& x, const Point& e) -> Attribute {
+    return {fixed(c), fixed(x), fixed(e)};
+  };
+
+  Attribute r{}, g{}, b{}, a{}, s{}, t{}, w{}, z{};
+  if(primitive.shaded) {
+    auto& shade = primitive.shade;
+    r = attribute(shade.r.c, shade.r.x, shade.r.e);
+    g = attribute(shade.g.c, shade.g.x, shade.g.e);
+    b = attribute(shade.b.c, shade.b.x, shade.b.e);
+    a = attribute(shade.a.c, shade.a.x, shade.a.e);
+  }
+  if(primitive.textured) {
+    auto& texture = primitive.texture;
+    s = attribute(texture.s.c, texture.s.x, texture.s.e);
+    t = attribute(texture.t.c, texture.t.x, texture.t.e);
+    w = attribute(texture.w.c, texture.w.x, texture.w.e);
+  }
+  if(primitive.zbuffered) {
+    auto& zbuffer = primitive.zbuffer;
+    z = attribute(zbuffer.d, zbuffer.x, zbuffer.e);
+  }
+
+  //Y coordinates are s11.2; X coordinates and slopes are s15.16
+  s32 yh = sclip<14>(edge.y.hi);
+  s32 ym = sclip<14>(edge.y.md);
+  s32 yl = sclip<14>(edge.y.lo);
+  s64 xh = fixed(edge.x.hi.c), dxh = fixed(edge.x.hi.s);
+  s64 xm = fixed(edge.x.md.c), dxm = fixed(edge.x.md.s);
+  s64 xl = fixed(edge.x.lo.c), dxl = fixed(edge.x.lo.s);
+
+  s32 width = state.set.color.width + 1;
+  s32 left  = state.scissor.x.hi >> 2;
+  s32 right = min<s32>(state.scissor.x.lo >> 2, width);
+  s32 top    = max<s32>(yh + 3 >> 2, state.scissor.y.hi >> 2);
+  s32 bottom = min<s32>(yl + 3 >> 2, state.scissor.y.lo >> 2);
+
+  for(s32 y = max(top, 0); y < bottom; y++) {
+    if(y / Band % count != index) continue;
+
+    //XH and XM are given at the scanline containing YH; XL at the one containing YM
+    s64 dy = y - (yh >> 2);
+    s64 major = xh + dxh * dy;
+    s64 minor = y << 2 < ym ? xm + dxm * dy : xl + dxl * (y - (ym >> 2));
+    s32 x0 = max<s64>(min(major, minor) + 0xffff >> 16, max(left, 0));
+    s32 x1 = min<s64>(max(major, minor) + 0xffff >> 16, right);
+
+    for(s32 x = x0; x < x1; x++) {
+      s64 dx = ((s64)x << 16) - major;
+      auto value = [&](const Attribute& attribute) -> s64 {
+        return attribute.c + attribute.e * dy + (attribute.x * dx >> 16);
+      };
+
+      Fragment fragment{};
+      if(primitive.shaded) {
+        fragment.shade.r = clamp9(value(r) >> 16);
+        fragment.shade.g = clamp9(value(g) >> 16);
+        fragment.shade.b = clamp9(value(b) >> 16);
+        fragment.shade.a = clamp9(value(a) >> 16);
+      }
+      if(primitive.textured) {
+        s64 sv = value(s), tv = value(t), wv = value(w);
+        if(state.other.perspective && wv > 0) {
+          //W is the normalized inverse depth, where 0x7fff.ffff represents 1.0
+          fragment.s = sclamp<16>((sv << 15) / wv);
+          fragment.t = sclamp<16>((tv << 15) / wv);
+        } else {
+          fragment.s = sclamp<16>(sv >> 16);
+          fragment.t = sclamp<16>(tv >> 16);
+        }
+      }
+      if(primitive.zbuffered) {
+        fragment.z = max<s64>(0, min<s64>(0x3ffff, value(z) >> 13));
+      }
+      pixel(primitive, fragment, x, y, edge.tile);
+    }
+  }
+}
+
+auto RDP::Rasterizer::drawRectangle(const Primitive& primitive, u32 index, u32 count) -> void {
+  auto& state = primitive.state;
+  auto& rectangle = primitive.rectangle;
+  bool copy = state.other.cycleType == 2;
+  bool fill = state.other.cycleType == 3;
+
+  //coordinates are u10.2. the lower-right edge is inclusive in fill and copy modes
+  s32 x0 = rectangle.x.hi >> 2, x1 = rectangle.x.lo + 3 >> 2;
+  s32 y0 = rectangle.y.hi >> 2, y1 = rectangle.y.lo + 3 >> 2;
+  if(copy || fill) x1 = (rectangle.x.lo >> 2) + 1, y1 = (rectangle.y.lo >> 2) + 1;
+
+  s32 width = state.set.color.width + 1;
+  s32 left   = max<s32>(x0, state.scissor.x.hi >> 2);
+  s32 right  = min<s32>(min<s32>(x1, state.scissor.x.lo >> 2), width);
+  s32 top    = max<s32>(y0, state.scissor.y.hi >> 2);
+  s32 bottom = min<s32>(y1, state.scissor.y.lo >> 2);
+  if(left >= right) return;
+
+  //S and T are s10.5; their per-pixel steps are s5.10. copy mode steps four pixels per clock
+  s32 s  = sclip<16>(rectangle.s.i);
+  s32 t  = sclip<16>(rectangle.t.i);
+  s32 ds = sclip<16>(rectangle.s.f);
+  s32 dt = sclip<16>(rectangle.t.f);
+  if(copy) ds >>= 2;
+
+  for(s32 y = top; y < bottom; y++) {
+    if(y / Band % count != index) continue;
+    if(fill) {
+      this->fill(state, y, left, right);
+      continue;
+    }
+
+    for(s32 x = left; x < right; x++) {
+      Fragment fragment{};
+      if(primitive.textured) {
+        s32 dx = x - x0, dy = y - y0;
+        fragment.s = s + (ds * (primitive.flipped ? dy : dx) >> 5);
+        fragment.t = t + (dt * (primitive.flipped ? dx : dy) >> 5);
+      }
+      if(copy) {
+        auto color = sample(state, rectangle.tile, fragment.s, fragment.t);
+        if(state.other.alphaCompare && !color.a) continue;
+        writeColor(state, x, y, color);
+        continue;
+      }
+      pixel(primitive, fragment, x, y, rectangle.tile);
+    }
+  }
+}
+
+//writes the fill color over [x0, x1) of scanline y. the fill color is a 32-bit pattern repeated through memory,
+//and whole words of RDRAM are stored in host order, so aligned words are written with vector stores.
+auto RDP::Rasterizer::fill(const State& state, u32 y, u32 x0, u32 x1) -> void {
+  u32 size = state.set.color.size;
+  if(size == 0 || x0 >= x1) return;  //4bpp images cannot be filled
+  u32 width = state.set.color.width + 1;
+  u32 color = state.set.fill.color;
+  u32 address = state.set.color.dramAddress + ((y * width + x0) << size >> 1);
+  u32 length = (x1 - x0) << size >> 1;
+  auto& ram = rdram.ram;
+
+  for(; length && address & 3; address++, length--) {
+    ram.write<Byte>(address, color >> 8 * (3 - (address & 3)));
+  }
+
+  u32 words = length >> 2;
+  u32 offset = address & ram.maskWord;
+  if(offset + words * 4 <= ram.maskByte + 1) {
+    auto target = (u32*)(ram.data + offset);
+    u32 index = 0;
+    #if defined(__SSE2__)
+    auto pattern = _mm_set1_epi32(color);
+    for(; index + 4 <= words; index += 4) {
+      _mm_storeu_si128((__m128i*)(target + index), pattern);
+    }
+    #endif
+    for(; index < words; index++) target[index] = color;
+  } else {
+    for(u32 index : range(words)) ram.write<Word>(address + index * 4, color);
+  }
+  address += words * 4;
+  length &= 3;
+
+  for(; length; address++, length--) {
+    ram.write<Byte>(address, color >> 8 * (3 - (address & 3)));
+  }
+}
+
+auto RDP::Rasterizer::pixel(const Primitive& primitive, const Fragment& fragment, u32 x, u32 y, u32 tile) -> void {
+  auto& state = primitive.state;
+  auto& other = state.other;
+  if(other.cycleType == 3) return fill(state, y, x, x + 1);
+
+  Inputs inputs;
+  inputs.shade = fragment.shade;
+  inputs.primitive = {state.primitive.red, state.primitive.green, state.primitive.blue, state.primitive.alpha};
+  inputs.environment = {state.environment.red, state.environment.green, state.environment.blue, state.environment.alpha};
+  inputs.noise = (x * 0x9e37'79b1 ^ y * 0x85eb'ca6b) >> 24;
+  inputs.lodFraction = 0;  //mipmapping is not emulated
+  inputs.primitiveLodFraction = state.primitive.fraction;
+  inputs.texel0 = {};
+  inputs.texel1 = {};
+  if(primitive.textured) {
+    inputs.texel0 = sample(state, tile, fragment.s, fragment.t);
+    inputs.texel1 = other.cycleType == 1 ? sample(state, tile + 1, fragment.s, fragment.t) : inputs.texel0;
+  }
+
+  //one-cycle mode uses the settings of the second cycle
+  Color color;
+  if(other.cycleType == 1) {
+    color = combine(state, 0, inputs, {});
+    color = combine(state, 1, inputs, color);
+  } else {
+    color = combine(state, 1, inputs, {});
+  }
+
+  if(other.alphaCompare) {
+    s32 threshold = other.ditherAlpha ? inputs.noise : (s32)state.blend.alpha;
+    if(color.a < threshold) return;
+  }
+
+  u32 width = state.set.color.width + 1;
+  u32 zAddress = state.set.mask.dramAddress + (y * width + x) * 2;
+  u32 z = other.zSource ? (u32)state.primitiveDepth.z << 3 & 0x3ffff : fragment.z;
+  if(other.zCompare) {
+    u32 depth = zDecompress(rdram.ram.read<Half>(zAddress) >> 2);
+    bool pass = other.zMode == 2 ? z < depth : z <= depth;
+    if(other.zMode == 3) pass = max(z, depth) - min(z, depth) <= 0x100;  //decal: only coplanar surfaces
+    if(!pass) return;
+  }
+
+  Color memory = {};
+  if(other.imageRead || other.forceBlend) memory = readColor(state, x, y);
+  Color fog = {state.fog.red, state.fog.green, state.fog.blue, state.fog.alpha};
+  Color blend = {state.blend.red, state.blend.green, state.blend.blue, state.blend.alpha};
+
+  //computes (P * A + M * B) / 255; outside of forced blending, the last cycle passes P through,
+  //as partial coverage is not emulated.
+  auto blender = [&](u32 cycle, Color pixel, bool last) -> Color {
+    auto input = [&](u32 select) -> Color {
+      if(select == 0) return pixel;
+      if(select == 1) return memory;
+      if(select == 2) return blend;
+      return fog;
+    };
+    Color p = input(other.blend1a[cycle]);
+    Color m = input(other.blend2a[cycle]);
+    if(last && !other.forceBlend) return {p.r, p.g, p.b, pixel.a};
+
+    s32 a = 0, b = 0;
+    switch(other.blend1b[cycle]) {
+    case 0: a = pixel.a; break;
+    case 1: a = state.fog.alpha; break;
+    case 2: a = fragment.shade.a; break;
+    }
+    switch(other.blend2b[cycle]) {
+    case 0: b = 255 - a; break;
+    case 1: b = memory.a; break;
+    case 2: b = 255; break;
+    }
+    return {
+      min(255, (p.r * a + m.r * b) / 255),
+      min(255, (p.g * a + m.g * b) / 255),
+      min(255, (p.b * a + m.b * b) / 255),
+      pixel.a,
+    };
+  };
+  if(other.cycleType == 1) {
+    color = blender(1, blender(0, color, false), true);
+  } else {
+    color = blender(0, color, true);
+  }
+
+  writeColor(state, x, y, color);
+  if(other.zUpdate) rdram.ram.write<Half>(zAddress, zCompress(z) << 2);
+}
+
+//applies the tile's shift, origin, clamp, mirror, and mask to s10.5 coordinates, then point-samples.
+auto RDP::Rasterizer::sample(const State& state, u32 index, s32 s, s32 t) const -> Color {
+  auto& tile = state.tiles[index & 7];
+  auto coordinate = [](s32 c, auto& axis) -> u32 {
+    if(axis.shift < 11) c >>= axis.shift;
+    else c <<= 16 - axis.shift;
+    c -= (s32)axis.lo << 3;
+    s32 texel = c >> 5;
+    if(axis.clamp || !axis.mask) {
+      s32 limit = ((s32)axis.hi - (s32)axis.lo) >> 2;
+      texel = max(0, min(texel, max(limit, 0)));
+    }
+    if(axis.mask) {
+      if(axis.mirror && texel >> axis.mask & 1) texel = ~texel;
+      texel &= (1 << axis.mask) - 1;
+    }
+    return texel;
+  };
+  return texel(state, tile, coordinate(s, tile.s), coordinate(t, tile.t));
+}
+
+auto RDP::Rasterizer::texel(const State& state, const TileDescriptor& tile, u32 s, u32 t) const -> Color {
+  auto read16 = [&](u32 address) -> u32 {
+    address &= 0xffe;
+    return self.tmem[address] << 8 | self.tmem[address + 1];
+  };
+  auto rgba16 = [](u32 value) -> Color {
+    return {expand5(value >> 11), expand5(value >> 6), expand5(value >> 1), value & 1 ? 255 : 0};
+  };
+
+  //odd rows are stored with their 32-bit words swapped
+  u32 swap = (t & 1) << 2;
+
+  if(tile.size == 3) {
+    //32-bit texels are split: red and green in the lower half of TMEM; blue and alpha in the upper half
+    u32 index = (tile.address * 4 + t * tile.line * 4 + s ^ swap >> 1) & 0x3ff;
+    u32 rg = read16(index << 1);
+    u32 ba = read16((index | 0x400) << 1);
+    return {s32(rg >> 8), s32(rg & 255), s32(ba >> 8), s32(ba & 255)};
+  }
+
+  u32 address = (tile.address * 8 + t * tile.line * 8 + (s << tile.size >> 1)) ^ swap;
+  u32 value = 0;
+  if(tile.size == 0) value = self.tmem[address & 0xfff] >> (s & 1 ? 0 : 4) & 15;
+  if(tile.size == 1) value = self.tmem[address & 0xfff];
+  if(tile.size == 2) value = read16(address);
+
+  if(state.other.tlut && tile.size <= 1) {
+    //palette entries are stored four times over in the upper half of TMEM
+    u32 index = tile.size == 0 ? tile.palette << 4 | value : value;
+    u32 entry = read16(0x800 + index * 8);
+    if(state.other.tlutType == 0) return rgba16(entry);
+    return {s32(entry >> 8), s32(entry >> 8), s32(entry >> 8), s32(entry & 255)};
+  }
+
+  if(tile.format == 0 && tile.size == 2) return rgba16(value);
+
+  if(tile.format == 3) {
+    if(tile.size == 0) {
+      u32 i = value >> 1;
+      i = i << 5 | i << 2 | i >> 1;
+      return {s32(i), s32(i), s32(i), value & 1 ? 255 : 0};
+    }
+    if(tile.size == 1) {
+      return {s32(value >> 4) * 17, s32(value >> 4) * 17, s32(value >> 4) * 17, s32(value & 15) * 17};
+    }
+    if(tile.size == 2) {
+      return {s32(value >> 8), s32(value >> 8), s32(value >> 8), s32(value & 255)};
+    }
+  }
+
+  //intensity, and formats without a distinct color meaning
+  s32 i = tile.size == 0 ? value * 17 : tile.size == 1 ? value : value >> 8;
+  return {i, i, i, i};
+}
+
+//computes (A - B) * C + D for each channel of one cycle.
+auto RDP::Rasterizer::combine(const State& state, u32 cycle, const Inputs& inputs, Color combined) const -> Color {
+  auto& mode = state.combine;
+  static constexpr Color zero = {0, 0, 0, 0};
+  static constexpr Color one = {255, 255, 255, 255};
+
+  auto common = [&](u32 select) -> const Color& {
+    switch(select) {
+    case 0: return combined;
+    case 1: return inputs.texel0;
+    case 2: return inputs.texel1;
+    case 3: return inputs.primitive;
+    case 4: return inputs.shade;
+    case 5: return inputs.environment;
+    }
+    return zero;
+  };
+  auto broadcast = [](s32 value) -> Color { return {value, value, value, value}; };
+
+  u32 select = mode.sba.color[cycle];
+  Color a = select <= 5 ? common(select) : select == 6 ? one : select == 7 ? broadcast(inputs.noise) : zero;
+  select = mode.sbb.color[cycle];
+  Color b = select <= 5 ? common(select) : select == 7 ? broadcast(sclip<9>(state.convert.k[4])) : zero;
+  select = mode.mul.color[cycle];
+  Color c = select <= 5 ? common(select) : zero;
+  if(select >= 7 && select <= 12) c = broadcast(common(select - 7).a);
+  if(select == 13) c = broadcast(inputs.lodFraction);
+  if(select == 14) c = broadcast(inputs.primitiveLodFraction);
+  if(select == 15) c = broadcast(state.convert.k[5]);
+  select = mode.add.color[cycle];
+  Color d = select <= 5 ? common(select) : select == 6 ? one : zero;
+
+  auto alpha = [&](u32 select) -> s32 {
+    return select <= 5 ? common(select).a : select == 6 ? 255 : 0;
+  };
+  s32 aa = alpha(mode.sba.alpha[cycle]);
+  s32 ab = alpha(mode.sbb.alpha[cycle]);
+  s32 ad = alpha(mode.add.alpha[cycle]);
+  select = mode.mul.alpha[cycle];
+  s32 ac = select == 0 ? inputs.lodFraction : select <= 5 ? common(select).a : select == 6 ? inputs.primitiveLodFraction : 0;
+
+  auto channel = [](s32 a, s32 b, s32 c, s32 d) -> s32 {
+    return max(0, min(255, ((a - b) * c + (d << 8) + 0x80) >> 8));
+  };
+  return {
+    channel(a.r, b.r, c.r, d.r),
+    channel(a.g, b.g, c.g, d.g),
+    channel(a.b, b.b, c.b, d.b),
+    channel(aa, ab, ac, ad),
+  };
+}
+
+auto RDP::Rasterizer::readColor(const State& state, u32 x, u32 y) const -> Color {
+  u32 width = state.set.color.width + 1;
+  u32 address = state.set.color.dramAddress + ((y * width + x) << state.set.color.size >> 1);
+  if(state.set.color.size == 1) {
+    s32 data = rdram.ram.read<Byte>(address);
+    return {data, data, data, data};
+  }
+  if(state.set.color.size == 2) {
+    u32 data = rdram.ram.read<Half>(address);
+    return {expand5(data >> 11), expand5(data >> 6), expand5(data >> 1), data & 1 ? 255 : 0};
+  }
+  if(state.set.color.size == 3) {
+    u32 data = rdram.ram.read<Word>(address);
+    return {s32(data >> 24), s32(data >> 16 & 255), s32(data >> 8 & 255), s32(data & 255)};
+  }
+  return {};
+}
+
+auto RDP::Rasterizer::writeColor(const State& state, u32 x, u32 y, Color color) -> void {
+  u32 width = state.set.color.width + 1;
+  u32 address = state.set.color.dramAddress + ((y * width + x) << state.set.color.size >> 1);
+  if(state.set.color.size == 1) {
+    rdram.ram.write<Byte>(address, color.r);
+  }
+  if(state.set.color.size == 2) {
+    //the low bit holds coverage, which is always full here
+    rdram.ram.write<Half>(address, (color.r >> 3) << 11 | (color.g >> 3) << 6 | (color.b >> 3) << 1 | 1);
+  }
+  if(state.set.color.size == 3) {
+    rdram.ram.write<Word>(address, color.r << 24 | color.g << 16 | color.b << 8 | color.a);
+  }
+}
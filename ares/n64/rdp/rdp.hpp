@@ -327,6 +327,117 @@ struct RDP : Thread, Memory::IO<RDP> {
     } x, y;
   } fillRectangle_;
 
+  //the state set by Set_Tile and Set_Tile_Size for each of the eight tiles
+  struct TileDescriptor {
+    n3 format;
+    n2 size;
+    n9 line;
+    n9 address;
+    n4 palette;
+    struct {
+      n1  clamp;
+      n1  mirror;
+      n4  mask;
+      n4  shift;
+      n12 lo;
+      n12 hi;
+    } s, t;
+  } tiles[8];
+
+  u8 tmem[4_KiB];  //big-endian byte order; the upper half holds palettes and the second half of 32-bit texels
+
+  //rasterizer.cpp: software renderer for builds and hosts without Vulkan.
+  //primitives are queued along with the state they were issued under, then rasterized in parallel:
+  //every host thread walks every queued primitive, but only draws the bands of scanlines it owns.
+  struct Rasterizer {
+    RDP& self;
+    Rasterizer(RDP& self) : self(self) {}
+
+    static constexpr u32 Band = 8;     //scanlines per band
+    static constexpr u32 Threads = 8;  //most host threads to use, including the one issuing commands
+    static constexpr u32 Batch = 4;    //smaller queues are rasterized on the issuing thread alone
+
+    struct State {
+      OtherModes other;
+      CombineMode combine;
+      FogColor fog;
+      Blend blend;
+      PrimitiveColor primitive;
+      EnvironmentColor environment;
+      PrimitiveDepth primitiveDepth;
+      Scissor scissor;
+      Convert convert;
+      Set set;
+      TileDescriptor tiles[8];
+    };
+
+    struct Primitive {
+      enum class Type : u32 { Triangle, Rectangle } type;
+      bool shaded;
+      bool textured;
+      bool zbuffered;
+      bool flipped;
+      State state;
+      Edge edge;
+      Shade shade;
+      Texture texture;
+      Zbuffer zbuffer;
+      TextureRectangle rectangle;
+    };
+
+    struct Color {
+      s32 r, g, b, a;
+    };
+
+    struct Fragment {
+      Color shade;
+      s32 s, t;  //s10.5 texture coordinates
+      u32 z;     //18-bit depth
+    };
+
+    //the color combiner inputs that do not depend on the cycle
+    struct Inputs {
+      Color texel0;
+      Color texel1;
+      Color primitive;
+      Color shade;
+      Color environment;
+      s32 noise;
+      s32 lodFraction;
+      s32 primitiveLodFraction;
+    };
+
+    //rasterizer.cpp
+    auto triangle(bool shaded, bool textured, bool zbuffered) -> void;
+    auto rectangle(bool textured, bool flipped) -> void;
+    auto flush() -> void;
+    auto main(uintptr_t index) -> void;
+    auto kill() -> void;
+    auto power() -> void;
+
+    auto snapshot() const -> State;
+    auto draw(const Primitive&, u32 index, u32 count) -> void;
+    auto drawTriangle(const Primitive&, u32 index, u32 count) -> void;
+    auto drawRectangle(const Primitive&, u32 index, u32 count) -> void;
+    auto fill(const State&, u32 y, u32 x0, u32 x1) -> void;
+    auto pixel(const Primitive&, const Fragment&, u32 x, u32 y, u32 tile) -> void;
+    auto sample(const State&, u32 tile, s32 s, s32 t) const -> Color;
+    auto texel(const State&, const TileDescriptor&, u32 s, u32 t) const -> Color;
+    auto combine(const State&, u32 cycle, const Inputs&, Color combined) const -> Color;
+    auto readColor(const State&, u32 x, u32 y) const -> Color;
+    auto writeColor(const State&, u32 x, u32 y, Color) -> void;
+
+    vector<Primitive> batch;
+    nall::thread handles[Threads];
+    u32 threads = 0;  //host threads started, including the issuing thread; zero until first needed
+    mutex lock;
+    condition_variable wake;
+    condition_variable done;
+    bool pending[Threads] = {};  //whether each thread has yet to draw its bands of the batch
+    u32 remaining = 0;
+    bool quit = false;
+  } rasterizer{*this};
+
   struct IO : Memory::IO<IO> {
     RDP& self;
     IO(RDP& self) : self(self) {}
@@ -544,6 +544,8 @@ auto RDP::render() -> void {
 
     }
   }
+
+  rasterizer.flush();
 }
 
 //0x00
@@ -556,42 +558,52 @@ auto RDP::invalidOperation() -> void {
 
 //0x08
 auto RDP::unshadedTriangle() -> void {
+  rasterizer.triangle(0, 0, 0);
 }
 
 //0x09
 auto RDP::unshadedZbufferTriangle() -> void {
+  rasterizer.triangle(0, 0, 1);
 }
 
 //0x0a
 auto RDP::textureTriangle() -> void {
+  rasterizer.triangle(0, 1, 0);
 }
 
 //0x0b
 auto RDP::textureZbufferTriangle() -> void {
+  rasterizer.triangle(0, 1, 1);
 }
 
 //0x0c
 auto RDP::shadedTriangle() -> void {
+  rasterizer.triangle(1, 0, 0);
 }
 
 //0x0d
 auto RDP::shadedZbufferTriangle() -> void {
+  rasterizer.triangle(1, 0, 1);
 }
 
 //0x0e
 auto RDP::shadedTextureTriangle() -> void {
+  rasterizer.triangle(1, 1, 0);
 }
 
 //0x0f
 auto RDP::shadedTextureZbufferTriangle() -> void {
+  rasterizer.triangle(1, 1, 1);
 }
 
 //0x24
 auto RDP::textureRectangle() -> void {
+  rasterizer.rectangle(1, 0);
 }
 
 //0x25
 auto RDP::textureRectangleFlip() -> void {
+  rasterizer.rectangle(1, 1);
 }
 
 //0x26
@@ -608,6 +620,7 @@ auto RDP::syncTile() -> void {
 
 //0x29
 auto RDP::syncFull() -> void {
+  rasterizer.flush();
   mi.raise(MI::IRQ::DP);
 }
 
@@ -637,26 +650,138 @@ auto RDP::setOtherModes() -> void {
 
 //0x30
 auto RDP::loadTLUT() -> void {
+  rasterizer.flush();
+  auto& descriptor = tiles[tlut.index];
+  descriptor.s.lo = tlut.s.lo;
+  descriptor.s.hi = tlut.s.hi;
+  descriptor.t.lo = tlut.t.lo;
+  descriptor.t.hi = tlut.t.hi;
+
+  //each 16-bit palette entry is stored four times over, once per TMEM bank
+  u32 width = set.texture.width + 1;
+  u32 first = tlut.s.lo >> 2, last = tlut.s.hi >> 2;
+  u32 source = set.texture.dramAddress + ((tlut.t.lo >> 2) * width + first) * 2;
+  for(u32 index = 0; first + index <= last && index < 256; index++) {
+    u16 entry = rdram.ram.read<Half>(source + index * 2);
+    for(u32 bank : range(4)) {
+      u32 address = descriptor.address * 8 + index * 8 + bank * 2 & 0xffe;
+      tmem[address + 0] = entry >> 8;
+      tmem[address + 1] = entry >> 0;
+    }
+  }
 }
 
 //0x32
 auto RDP::setTileSize() -> void {
+  auto& descriptor = tiles[tileSize.index];
+  descriptor.s.lo = tileSize.s.lo;
+  descriptor.s.hi = tileSize.s.hi;
+  descriptor.t.lo = tileSize.t.lo;
+  descriptor.t.hi = tileSize.t.hi;
 }
 
 //0x33
 auto RDP::loadBlock() -> void {
+  rasterizer.flush();
+  auto& descriptor = tiles[load_.block.index];
+  descriptor.s.lo = load_.block.s.lo;
+  descriptor.s.hi = load_.block.s.hi;
+  descriptor.t.lo = load_.block.t.lo;
+  descriptor.t.hi = load_.block.t.hi;
+
+  //copies texels linearly; DxT advances a 1.11 line counter per 64-bit word, and odd lines are stored swapped
+  u32 width = set.texture.width + 1;
+  u32 size = set.texture.size;
+  u32 dxt = load_.block.t.hi;
+  u32 source = set.texture.dramAddress + ((load_.block.t.lo * width + load_.block.s.lo) << size >> 1);
+  u32 texels = load_.block.s.hi >= load_.block.s.lo ? load_.block.s.hi - load_.block.s.lo + 1 : 0;
+  u32 words = min(((texels << size >> 1) + 7) >> 3, 512u);
+  for(u32 word : range(words)) {
+    u32 swap = (word * dxt >> 11 & 1) << 2;
+    for(u32 byte : range(8)) {
+      u8 data = rdram.ram.read<Byte>(source + word * 8 + byte);
+      if(size == 3) {
+        //32-bit texels: red and green to the lower half of TMEM; blue and alpha to the upper half
+        u32 index = (descriptor.address * 4 + word * 2 + (byte >> 2) ^ swap >> 1) & 0x3ff;
+        u32 half = byte & 2 ? 0x800 : 0x000;
+        tmem[half | index << 1 | byte & 1] = data;
+      } else {
+        tmem[(descriptor.address * 8 + word * 8 + byte ^ swap) & 0xfff] = data;
+      }
+    }
+  }
 }
 
 //0x34
 auto RDP::loadTile() -> void {
+  rasterizer.flush();
+  auto& descriptor = tiles[load_.tile.index];
+  descriptor.s.lo = load_.tile.s.lo;
+  descriptor.s.hi = load_.tile.s.hi;
+  descriptor.t.lo = load_.tile.t.lo;
+  descriptor.t.hi = load_.tile.t.hi;
+
+  //copies a rectangle of texels into rows of the tile's line length; odd rows are stored swapped
+  u32 width = set.texture.width + 1;
+  u32 size = set.texture.size;
+  u32 sl = load_.tile.s.lo >> 2, sh = load_.tile.s.hi >> 2;
+  u32 tl = load_.tile.t.lo >> 2, th = load_.tile.t.hi >> 2;
+  for(u32 t = tl; t <= th && t - tl < 4096; t++) {
+    u32 row = t - tl;
+    u32 swap = (row & 1) << 2;
+    for(u32 s = sl; s <= sh && s - sl < 4096; s++) {
+      u32 column = s - sl;
+      u32 source = set.texture.dramAddress + ((t * width + s) << size >> 1);
+      if(size == 0) {
+        u32 address = (descriptor.address * 8 + row * descriptor.line * 8 + (column >> 1) ^ swap) & 0xfff;
+        u32 shift = column & 1 ? 0 : 4;
+        u8 data = rdram.ram.read<Byte>(source) >> (s & 1 ? 0 : 4) & 15;
+        tmem[address] = tmem[address] & ~(15 << shift) | data << shift;
+      }
+      if(size == 1) {
+        u32 address = (descriptor.address * 8 + row * descriptor.line * 8 + column ^ swap) & 0xfff;
+        tmem[address] = rdram.ram.read<Byte>(source);
+      }
+      if(size == 2) {
+        u32 address = (descriptor.address * 8 + row * descriptor.line * 8 + column * 2 ^ swap) & 0xffe;
+        u16 data = rdram.ram.read<Half>(source);
+        tmem[address + 0] = data >> 8;
+        tmem[address + 1] = data >> 0;
+      }
+      if(size == 3) {
+        //32-bit texels: red and green to the lower half of TMEM; blue and alpha to the upper half
+        u32 index = (descriptor.address * 4 + row * descriptor.line * 4 + column ^ swap >> 1) & 0x3ff;
+        u32 data = rdram.ram.read<Word>(source);
+        tmem[index << 1 | 0x000] = data >> 24;
+        tmem[index << 1 | 0x001] = data >> 16;
+        tmem[index << 1 | 0x800] = data >>  8;
+        tmem[index << 1 | 0x801] = data >>  0;
+      }
+    }
+  }
 }
 
 //0x35
 auto RDP::setTile() -> void {
+  auto& descriptor = tiles[tile.index];
+  descriptor.format   = tile.format;
+  descriptor.size     = tile.size;
+  descriptor.line     = tile.line;
+  descriptor.address  = tile.address;
+  descriptor.palette  = tile.palette;
+  descriptor.s.clamp  = tile.s.clamp;
+  descriptor.s.mirror = tile.s.mirror;
+  descriptor.s.mask   = tile.s.mask;
+  descriptor.s.shift  = tile.s.shift;
+  descriptor.t.clamp  = tile.t.clamp;
+  descriptor.t.mirror = tile.t.mirror;
+  descriptor.t.mask   = tile.t.mask;
+  descriptor.t.shift  = tile.t.shift;
 }
 
 //0x36
 auto RDP::fillRectangle() -> void {
+  rasterizer.rectangle(0, 0);
 }
 
 //0x37
@@ -689,8 +814,10 @@ auto RDP::setTextureImage() -> void {
 
 //0x3e
 auto RDP::setMaskImage() -> void {
+  rasterizer.flush();
 }
 
 //0x3f
 auto RDP::setColorImage() -> void {
+  rasterizer.flush();
 }
@@ -13,6 +13,28 @@ auto RDP::serialize(serializer& s) -> void {
   s(command.flush);
   s(command.ready);
 
+  rasterizer.flush();
+  for(auto& tile : tiles) {
+    s(tile.format);
+    s(tile.size);
+    s(tile.line);
+    s(tile.address);
+    s(tile.palette);
+    s(tile.s.clamp);
+    s(tile.s.mirror);
+    s(tile.s.mask);
+    s(tile.s.shift);
+    s(tile.s.lo);
+    s(tile.s.hi);
+    s(tile.t.clamp);
+    s(tile.t.mirror);
+    s(tile.t.mask);
+    s(tile.t.shift);
+    s(tile.t.lo);
+    s(tile.t.hi);
+  }
+  s(tmem);
+
   s(io.bist.check);
   s(io.bist.go);
   s(io.bist.done);
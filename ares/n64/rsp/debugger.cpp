@@ -23,6 +23,11 @@ auto RSP::Debugger::load(Node::Object parent) -> void {
   tracer.instruction->setAddressBits(12, 2);
 
   tracer.io = parent->append<Node::Debugger::Tracer::Notification>("I/O", "RSP");
+
+  if constexpr(Accuracy::RSP::Recompiler) {
+    properties.recompiler = parent->append<Node::Debugger::Properties>("RSP Recompiler");
+    properties.recompiler->setQuery([&] { return rsp.recompiler.statistics(); });
+  }
 }
 
 auto RSP::Debugger::unload() -> void {
@@ -30,6 +35,7 @@ auto RSP::Debugger::unload() -> void {
   memory.imem.reset();
   tracer.instruction.reset();
   tracer.io.reset();
+  properties.recompiler.reset();
 }
 
 auto RSP::Debugger::instruction() -> void {
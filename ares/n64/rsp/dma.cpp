@@ -5,10 +5,7 @@ auto RSP::dmaTransfer() -> void {
 
   if(request.type == DMA::Request::Type::Read) {
     for(u32 block : range(request.count)) {
-      for(u32 offset = 0; offset < request.length; offset += 4) {
-        u32 data = bus.read<Word>(request.dramAddress + offset);
-        bus.write<Word>(region + request.pbusAddress + offset, data);
-      }
+      bus.copy<Word>(region + request.pbusAddress, request.dramAddress, request.length);
       request.pbusAddress += request.length;
       request.dramAddress += request.length + request.skip;
     }
@@ -16,10 +13,7 @@ auto RSP::dmaTransfer() -> void {
 
   if(request.type == DMA::Request::Type::Write) {
     for(u32 block : range(request.count)) {
-      for(u32 offset = 0; offset < request.length; offset += 4) {
-        u32 data = bus.read<Word>(region + request.pbusAddress + offset);
-        bus.write<Word>(request.dramAddress + offset, data);
-      }
+      bus.copy<Word>(request.dramAddress, region + request.pbusAddress, request.length);
       request.pbusAddress += request.length;
       request.dramAddress += request.length + request.skip;
     }
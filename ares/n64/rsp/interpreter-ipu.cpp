@@ -52,9 +52,11 @@ auto RSP::BNE(cr32& rs, cr32& rt, s16 imm) -> void {
 }
 
 auto RSP::BREAK() -> void {
-  status.halted = 1;
-  status.broken = 1;
-  if(status.interruptOnBreak) mi.raise(MI::IRQ::SP);
+  worker.forward([&] {
+    status.halted = 1;
+    status.broken = 1;
+    if(status.interruptOnBreak) mi.raise(MI::IRQ::SP);
+  });
   branch.halt();
 }
 
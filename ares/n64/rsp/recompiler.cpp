@@ -1,20 +1,19 @@
 auto RSP::Recompiler::pool() -> Pool* {
   if(context) return context;
 
-  context = (Pool*)allocator.acquire();
+  Pool pool;
   u32 hashcode = 0;
-  for(u32 offset : range(4096)) {
-    hashcode = (hashcode << 5) + hashcode + self.imem.read<Byte>(offset);
+  for(u32 offset = 0; offset < 4096; offset += 4) {
+    hashcode = (hashcode << 5) + hashcode + self.imem.read<Word>(offset);
   }
-  context->hashcode = hashcode;
+  pool.hashcode = hashcode;
 
-  if(auto result = pools.find(*context)) {
-    context->hashcode = 0;  //leave the memory zeroed out
+  if(auto result = pools.find(pool)) {
     return context = &result();
   }
 
-  allocator.reserve(sizeof(Pool));
-  if(auto result = pools.insert(*context)) {
+  for(auto& block : pool.blocks) block = nullptr;
+  if(auto result = pools.insert(pool)) {
     return context = &result();
   }
 
@@ -27,11 +26,31 @@ auto RSP::Recompiler::block(u32 address) -> Block* {
   return pool()->blocks[address >> 2 & 0x3ff] = block;
 }
 
+//discards the blocks emitted into the segment the allocator has just advanced to, so that it can be reused.
+auto RSP::Recompiler::recycle() -> void {
+  auto lo = allocator.acquire();
+  auto hi = lo + allocator.available();
+  for(auto& pool : pools) {
+    for(auto& block : pool.blocks) {
+      if((u8*)block >= lo && (u8*)block < hi) block = nullptr;
+    }
+  }
+  counters.evictions++;
+}
+
+auto RSP::Recompiler::statistics() const -> string {
+  string output;
+  output.append("Translations: ", counters.translations, "\n");
+  output.append("Evictions: ", counters.evictions, "\n");
+  output.append("Bytes: ", counters.bytes, "\n");
+  output.append("Microcodes: ", pools.size(), "\n");
+  return output;
+}
+
 auto RSP::Recompiler::emit(u32 address) -> Block* {
   if(unlikely(allocator.available() < 1_MiB)) {
-    print("RSP allocator flush\n");
-    allocator.release(bump_allocator::zero_fill);
-    reset();
+    allocator.advance();
+    recycle();
   }
 
   auto block = (Block*)allocator.acquire(sizeof(Block));
@@ -83,6 +102,8 @@ auto RSP::Recompiler::emit(u32 address) -> Block* {
   ret();
 
   allocator.reserve(size());
+  counters.translations++;
+  counters.bytes += size();
 //print(hex(PC, 8L), " ", instructions, " ", size(), "\n");
   return block;
 }
@@ -3,6 +3,7 @@
 namespace ares::Nintendo64 {
 
 RSP rsp;
+#include "worker.cpp"
 #include "dma.cpp"
 #include "io.cpp"
 #include "interpreter.cpp"
@@ -22,6 +23,7 @@ auto RSP::load(Node::Object parent) -> void {
 }
 
 auto RSP::unload() -> void {
+  worker.kill();
   debugger.unload();
   dmem.reset();
   imem.reset();
@@ -67,6 +69,7 @@ auto RSP::instructionEpilogue() -> bool {
 }
 
 auto RSP::power(bool reset) -> void {
+  worker.power();
   Thread::reset();
   dmem.fill();
   imem.fill();
@@ -23,6 +23,10 @@ struct RSP : Thread, Memory::IO<RSP> {
       Node::Debugger::Tracer::Instruction instruction;
       Node::Debugger::Tracer::Notification io;
     } tracer;
+
+    struct Properties {
+      Node::Debugger::Properties recompiler;
+    } properties;
   } debugger;
 
   //rsp.cpp
@@ -42,6 +46,46 @@ struct RSP : Thread, Memory::IO<RSP> {
     u32 instruction;
   } pipeline;
 
+  //worker.cpp: optionally runs the RSP on a second host thread, behind the CPU.
+  //the worker only executes instructions that touch RSP-private state. COP0 accesses and BREAK
+  //are forwarded to the CPU thread, and the CPU thread waits for the worker to catch up before
+  //it accesses DMEM, IMEM, or the RSP and RDP registers. host scheduling decides when forwarded
+  //accesses take effect, so this mode is not deterministic; when disabled, the RSP runs inline.
+  struct Worker {
+    RSP& self;
+    Worker(RSP& self) : self(self) {}
+
+    static constexpr u32 Quantum   =  16'384;  //clocks granted to the worker at a time
+    static constexpr s64 Lookahead =  65'536;  //clocks the worker may fall behind the CPU
+
+    auto synchronize() -> void {
+      if(active && !servicing) drain();
+    }
+
+    auto main(uintptr_t) -> void;
+    auto advance(u32 clocks) -> void;
+    auto drain() -> void;
+    auto service(unique_lock<mutex>& guard) -> void;
+    template<typename F> auto forward(F&& request) -> void;
+    auto kill() -> void;
+    auto power() -> void;
+
+    bool enabled = false;    //set by option() before the system is powered on
+    bool active = false;     //whether the worker thread is running
+    bool servicing = false;  //whether the CPU thread is performing a forwarded request
+    u32 pending = 0;         //clocks the CPU has run but not yet granted to the worker
+
+    nall::thread handle;
+    mutex lock;
+    condition_variable wake;  //signaled to the worker
+    condition_variable done;  //signaled to the CPU
+    s64 budget = 0;           //clocks granted but not yet claimed by the worker
+    bool running = false;     //whether the worker is executing claimed clocks
+    bool quit = false;
+    void (*request)(void*) = nullptr;
+    void* context = nullptr;
+  } worker{*this};
+
   //dma.cpp
   auto dmaTransfer() -> void;
 
@@ -319,6 +363,8 @@ struct RSP : Thread, Memory::IO<RSP> {
     RSP& self;
     Recompiler(RSP& self) : self(self) {}
 
+    static constexpr u32 Segments = 8;  //the code cache recycles the oldest eighth when it fills up
+
     struct Block {
       auto execute() -> void {
         ((void (*)())code)();
@@ -339,6 +385,8 @@ struct RSP : Thread, Memory::IO<RSP> {
     auto reset() -> void {
       context = nullptr;
       pools.reset();
+      allocator.release();
+      allocator.partition(Segments);
     }
 
     auto invalidate() -> void {
@@ -347,6 +395,8 @@ struct RSP : Thread, Memory::IO<RSP> {
 
     auto pool() -> Pool*;
     auto block(u32 address) -> Block*;
+    auto recycle() -> void;
+    auto statistics() const -> string;
 
     auto emit(u32 address) -> Block*;
     auto emitEXECUTE(u32 instruction) -> bool;
@@ -359,9 +409,16 @@ struct RSP : Thread, Memory::IO<RSP> {
 
     template<typename R, typename... P> auto call(R (RSP::*function)(P...)) -> void;
 
+    struct Counters {
+      u64 translations = 0;
+      u64 evictions = 0;  //segments recycled
+      u64 bytes = 0;      //of code emitted
+    };
+
     bump_allocator allocator;
     Pool* context = nullptr;
     set<Pool> pools;
+    Counters counters;
   //hashset<Pool> pools;
   } recompiler{*this};
 
@@ -1,4 +1,5 @@
 auto RSP::serialize(serializer& s) -> void {
+  worker.synchronize();
   Thread::serialize(s);
   s(dmem);
   s(imem);
@@ -0,0 +1,90 @@
+auto RSP::Worker::main(uintptr_t) -> void {
+  unique_lock<mutex> guard{lock};
+  while(true) {
+    wake.wait(guard, [&] { return quit || budget > 0; });
+    if(quit) break;
+    self.clock -= budget;
+    budget = 0;
+    running = true;
+    guard.unlock();
+    while(self.clock < 0) self.main();
+    guard.lock();
+    running = false;
+    done.notify_all();
+  }
+}
+
+//called by the CPU thread in place of running the RSP inline.
+auto RSP::Worker::advance(u32 clocks) -> void {
+  pending += clocks;
+  if(pending < Quantum) return;
+
+  unique_lock<mutex> guard{lock};
+  budget += pending;
+  pending = 0;
+  wake.notify_all();
+  while(request || budget > Lookahead) {
+    if(request) service(guard);
+    else done.wait(guard);
+  }
+}
+
+//waits until the worker has executed every clock the CPU has run, performing its requests meanwhile.
+auto RSP::Worker::drain() -> void {
+  unique_lock<mutex> guard{lock};
+  budget += pending;
+  pending = 0;
+  wake.notify_all();
+  while(request || budget > 0 || running) {
+    if(request) service(guard);
+    else done.wait(guard);
+  }
+}
+
+//performs a request on the CPU thread while the worker waits for it.
+//the lock is released meanwhile, as the request may itself need to synchronize with the RSP.
+auto RSP::Worker::service(unique_lock<mutex>& guard) -> void {
+  servicing = true;
+  guard.unlock();
+  request(context);
+  guard.lock();
+  servicing = false;
+  request = nullptr;
+  wake.notify_all();
+}
+
+template<typename F>
+auto RSP::Worker::forward(F&& function) -> void {
+  if(!active) return function();
+
+  using Function = std::remove_reference_t<F>;
+  unique_lock<mutex> guard{lock};
+  request = [](void* context) { (*(Function*)context)(); };
+  context = (void*)&function;
+  done.notify_all();
+  wake.wait(guard, [&] { return !request; });
+}
+
+auto RSP::Worker::kill() -> void {
+  if(!active) return;
+  drain();
+  {
+    lock_guard<mutex> guard{lock};
+    quit = true;
+    wake.notify_all();
+  }
+  handle.join();
+  active = false;
+  quit = false;
+}
+
+auto RSP::Worker::power() -> void {
+  kill();
+  pending = 0;
+  budget = 0;
+  running = false;
+  request = nullptr;
+  if(!enabled) return;
+  handle = nall::thread::create({&RSP::Worker::main, this});
+  active = true;
+}
@@ -1,19 +1,13 @@
 auto SI::dmaRead() -> void {
   run();
-  for(u32 offset = 0; offset < 64; offset += 2) {
-    u16 data = bus.read<Half>(io.readAddress + offset);
-    bus.write<Half>(io.dramAddress + offset, data);
-  }
+  bus.copy<Half>(io.dramAddress, io.readAddress, 64);
   io.dmaBusy = 0;
   io.interrupt = 1;
   mi.raise(MI::IRQ::SI);
 }
 
 auto SI::dmaWrite() -> void {
-  for(u32 offset = 0; offset < 64; offset += 2) {
-    u16 data = bus.read<Half>(io.dramAddress + offset);
-    bus.write<Half>(io.writeAddress + offset, data);
-  }
+  bus.copy<Half>(io.writeAddress, io.dramAddress, 64);
   io.dmaBusy = 0;
   io.interrupt = 1;
   mi.raise(MI::IRQ::SI);
@@ -15,6 +15,8 @@ auto load(Node::System& node, string name) -> bool {
 }
 
 auto option(string name, string value) -> bool {
+  if(name == "Threaded RSP") rsp.worker.enabled = value.boolean();
+  if(name == "Threaded VI") vi.threaded = value.boolean();
   #if defined(VULKAN)
   if(name == "Quality" && value == "SD" ) vulkan.internalUpscale = 1;
   if(name == "Quality" && value == "HD" ) vulkan.internalUpscale = 2;
@@ -67,6 +67,12 @@ auto VI::main() -> void {
       #endif
 
       refreshed = true;
+      latch();
+      #if defined(VULKAN)
+      if(!threaded && !gpuOutputValid) scanout(screen->pixels(0).data());
+      #else
+      if(!threaded) scanout(screen->pixels(0).data());
+      #endif
       screen->frame();
     }
   }
@@ -104,31 +110,91 @@ auto VI::refresh() -> void {
   }
   #endif
 
-  u32 pitch  = vi.io.width;
-  u32 width  = vi.io.width;  //vi.io.xscale <= 0x300 ? 320 : 640;
-  u32 height = vi.io.yscale <= 0x400 ? 239 : 478;
-  screen->setViewport(0, 0, width, height);
-
-  if(vi.io.colorDepth == 2) {
-    //15bpp
-    for(u32 y : range(height)) {
-      u32 address = vi.io.dramAddress + y * pitch * 2;
-      auto line = screen->pixels(1).data() + y * 640;
-      for(u32 x : range(min(width, pitch))) {
+  screen->setViewport(0, 0, output.width, output.height);
+  if(threaded) scanout(screen->pixels(1).data());
+}
+
+auto VI::latch() -> void {
+  //the visible area is the active region of the display, scaled by the 2.10 fixed-point scale factors
+  u32 pitch  = io.width;
+  u32 width  = pitch;
+  u32 height = io.yscale <= 0x400 ? 239 : 478;
+  if(io.hend > io.hstart && io.xscale) width = (io.hend - io.hstart) * io.xscale >> 10;
+  if(io.vend > io.vstart && io.yscale) height = (io.vend - io.vstart >> 1) * io.yscale >> 10;
+
+  output.colorDepth  = io.colorDepth;
+  output.dramAddress = io.dramAddress;
+  output.pitch  = pitch;
+  output.width  = min(width, pitch, screen->canvasWidth());
+  output.height = min(height, screen->canvasHeight());
+}
+
+//converts the latched framebuffer into the screen's native color format.
+//each line is read straight out of RDRAM, unless it falls outside of it.
+auto VI::scanout(u32* target) -> void {
+  auto& ram = rdram.ram;
+  u32 pitch  = output.pitch;
+  u32 width  = output.width;
+  u32 canvas = screen->canvasWidth();
+
+  if(output.colorDepth == 2) {
+    //15bpp: 1<<24 selects the 5:5:5 half of the palette
+    for(u32 y : range(output.height)) {
+      u32 address = output.dramAddress + y * pitch * 2;
+      auto line = target + y * canvas;
+      u32 x = 0;
+      if(address + width * 2 <= ram.size) {
+        if(address & 2 && x < width) {
+          line[x++] = 1 << 24 | ram.read<Half>(address) >> 1;
+        }
+        //each native word holds two pixels, with the first in the upper half
+        auto source = (const u32*)(ram.data + address + x * 2);
+        u32 pairs = width - x >> 1;
+        u32 pair = 0;
+        #if defined(__SSE2__)
+        auto tag = _mm_set1_epi32(1 << 24);
+        auto low = _mm_set1_epi32(0x7fff);
+        for(; pair + 4 <= pairs; pair += 4) {
+          auto data  = _mm_loadu_si128((const __m128i*)(source + pair));
+          auto first = _mm_or_si128(_mm_srli_epi32(data, 17), tag);
+          auto next  = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(data, 1), low), tag);
+          _mm_storeu_si128((__m128i*)(line + x + pair * 2 + 0), _mm_unpacklo_epi32(first, next));
+          _mm_storeu_si128((__m128i*)(line + x + pair * 2 + 4), _mm_unpackhi_epi32(first, next));
+        }
+        #endif
+        for(; pair < pairs; pair++) {
+          u32 data = source[pair];
+          line[x + pair * 2 + 0] = 1 << 24 | data >> 17;
+          line[x + pair * 2 + 1] = 1 << 24 | data >> 1 & 0x7fff;
+        }
+        x += pairs * 2;
+      }
+      for(; x < width; x++) {
         u16 data = bus.read<Half>(address + x * 2);
-        *line++ = 1 << 24 | data >> 1;
+        line[x] = 1 << 24 | data >> 1;
       }
     }
   }
 
-  if(vi.io.colorDepth == 3) {
-    //24bpp
-    for(u32 y : range(height)) {
-      u32 address = vi.io.dramAddress + y * pitch * 4;
-      auto line = screen->pixels(1).data() + y * 640;
-      for(u32 x : range(min(width, pitch))) {
+  if(output.colorDepth == 3) {
+    //24bpp: RGBA8888, discarding alpha
+    for(u32 y : range(output.height)) {
+      u32 address = output.dramAddress + y * pitch * 4;
+      auto line = target + y * canvas;
+      u32 x = 0;
+      if(address + width * 4 <= ram.size) {
+        auto source = (const u32*)(ram.data + address);
+        #if defined(__SSE2__)
+        for(; x + 4 <= width; x += 4) {
+          auto data = _mm_loadu_si128((const __m128i*)(source + x));
+          _mm_storeu_si128((__m128i*)(line + x), _mm_srli_epi32(data, 8));
+        }
+        #endif
+        for(; x < width; x++) line[x] = source[x] >> 8;
+      }
+      for(; x < width; x++) {
         u32 data = bus.read<Word>(address + x * 4);
-        *line++ = data >> 8;
+        line[x] = data >> 8;
       }
     }
   }
@@ -139,6 +205,7 @@ auto VI::power(bool reset) -> void {
   screen->power();
   io = {};
   refreshed = false;
+  output = {};
 
   #if defined(VULKAN)
   gpuOutputValid = false;
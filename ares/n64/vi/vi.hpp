@@ -21,6 +21,8 @@ struct VI : Thread, Memory::IO<VI> {
   auto main() -> void;
   auto step(u32 clocks) -> void;
   auto refresh() -> void;
+  auto latch() -> void;
+  auto scanout(u32* target) -> void;
   auto power(bool reset) -> void;
 
   //io.cpp
@@ -67,6 +69,16 @@ struct VI : Thread, Memory::IO<VI> {
 
 //unserialized:
   bool refreshed;
+  bool threaded = false;  //scan out on the screen refresh thread, rather than at the end of each frame
+
+  //the framebuffer layout of the last completed frame
+  struct Output {
+    n2  colorDepth;
+    n24 dramAddress;
+    u32 pitch = 0;
+    u32 width = 0;
+    u32 height = 0;
+  } output;
 
   #if defined(VULKAN)
   bool gpuOutputValid = false;
@@ -14,6 +14,9 @@ struct Accuracy {
 
     //breakpoints are expensive and not used by any commercial games
     static constexpr bool Breakpoints = 0 | Reference & !Recompiler;
+
+    //maps main RAM into host address space, so that recompiled loads and stores access it directly
+    static constexpr bool Fastmem = 1 & Recompiler & nall::recompiler::fastmem::supported;
   };
 
   struct GPU {
@@ -19,7 +19,17 @@ CPU cpu;
 
 auto CPU::load(Node::Object parent) -> void {
   node = parent->append<Node::Object>("CPU");
-  ram.allocate(2_MiB);
+  auto& fastmem = recompiler.fastmem;
+  if constexpr(Accuracy::CPU::Fastmem) {
+    //the region is indexed by virtual address: RAM and its mirrors appear in KUSEG, KSEG0 and KSEG1
+    if(!fastmem.reserve(4_GiB, 2_MiB)
+    || !fastmem.map(0x0000'0000, 8_MiB)
+    || !fastmem.map(0x8000'0000, 8_MiB)
+    || !fastmem.map(0xa000'0000, 8_MiB)
+    ) fastmem.reset();
+  }
+  if(fastmem) ram.allocate(2_MiB, fastmem.memory());
+  else ram.allocate(2_MiB);
   ram.setWaitStates(4, 4, 4);
   scratchpad.allocate(1_KiB);
   scratchpad.setWaitStates(0, 0, 0);
@@ -31,6 +41,7 @@ auto CPU::unload() -> void {
   debugger = {};
   scratchpad.reset();
   ram.reset();
+  recompiler.fastmem.reset();
   node.reset();
 }
 
@@ -85,7 +96,7 @@ auto CPU::instruction() -> void {
 
   if constexpr(Accuracy::CPU::Recompiler) {
     auto block = recompiler.block(ipu.pc);
-    block->execute();
+    recompiler.execute(block);
   }
 }
 
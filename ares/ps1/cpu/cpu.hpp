@@ -509,12 +509,20 @@ struct CPU : Thread {
     CPU& self;
     Recompiler(CPU& self) : self(self) {}
 
-    struct Block {
-      auto execute() -> void {
-        ((void (*)())code)();
-      }
+    //blocks exit through an inline cache of {cmp eax,imm32; jz rel32} entries.
+    //each entry is patched to jump straight to the block that followed the exit last time.
+    static constexpr u32 Entries = 2;
+    static constexpr u32 EntrySize = 11;
+    static constexpr s64 Budget = 512;  //clocks linked blocks may run before returning to the scheduler
+
+    struct Link {
+      u8* entry;
+      Link* next;
+    };
 
+    struct Block {
       u8* code;
+      Link* links;  //cache entries that jump to this block
     };
 
     struct Pool {
@@ -523,16 +531,37 @@ struct CPU : Thread {
 
     auto reset() -> void {
       for(u32 index : range(1 << 21)) pools[index] = nullptr;
+      for(u32 index : range(1 << 11)) pages[index] = 0;
+      fastmem.forget();
+      enter = nullptr;
     }
 
+    //stores only reach evict() when they hit a 4KiB page that contains translated code.
     auto invalidate(u32 address) -> void {
-      pools[address >> 8 & 0x1fffff] = nullptr;
+      u32 page = address >> 12 & 0x1ffff;
+      if(likely(!(pages[page >> 6] >> (page & 63) & 1))) return;
+      evict(address);
+    }
+
+    auto execute(Block* block) -> void {
+      ((void (*)(u8*))enter)(block->code);
     }
 
     auto pool(u32 address) -> Pool*;
     auto block(u32 address) -> Block*;
+    auto dispatch(u8* site) -> u8*;
+    auto link(u8* site, u32 pc, Block* block) -> void;
+    auto unlink(Pool* pool) -> void;
+    auto evict(u32 address) -> void;
 
     auto emit(u32 address) -> Block*;
+    auto emitStubs() -> void;
+    auto emitExit() -> void;
+    auto emitReturn() -> void;
+    auto emitStep(u32 clocks) -> void;
+    template<u32 Size, bool Signed> auto emitLoad(u32 instruction, void (CPU::*function)(u32&, cu32&, s16)) -> void;
+    template<u32 Size> auto emitStore(u32 instruction, void (CPU::*function)(cu32&, cu32&, s16)) -> void;
+    auto resolve(u32 label) -> void;
     auto emitEXECUTE(u32 instruction) -> bool;
     auto emitSPECIAL(u32 instruction) -> bool;
     auto emitREGIMM(u32 instruction) -> bool;
@@ -543,6 +572,12 @@ struct CPU : Thread {
 
     bump_allocator allocator;
     Pool* pools[1 << 21];  //2_MiB * sizeof(void*) = 16_MiB
+    u64 pages[1 << 11];     //one bit per 4KiB page of the 512MiB physical address space
+    vector<u32> exits;      //rel32 jumps to the exit of the current block
+    u8* enter = nullptr;    //saves host registers and jumps to the block passed as the first argument
+    u8* leave = nullptr;    //restores host registers and returns from enter
+    u8* dispatcher = nullptr;
+    nall::recompiler::fastmem fastmem;  //RAM mapped by virtual address, addressed through r13
   } recompiler{*this};
 
   struct Disassembler {
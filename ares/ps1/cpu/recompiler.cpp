@@ -7,32 +7,79 @@ auto CPU::Recompiler::pool(u32 address) -> Pool* {
 auto CPU::Recompiler::block(u32 address) -> Block* {
   if(auto block = pool(address)->blocks[address >> 2 & 0x3f]) return block;
   auto block = emit(address);
+  u32 page = address >> 12 & 0x1ffff;
+  pages[page >> 6] |= 1ull << (page & 63);
   return pool(address)->blocks[address >> 2 & 0x3f] = block;
 }
 
+//called by block exits that missed the inline cache: returns the next block to run, or nullptr to leave.
+auto CPU::Recompiler::dispatch(u8* site) -> u8* {
+  u32 pc = self.ipu.pc;
+  auto pool = pools[pc >> 8 & 0x1fffff];
+  if(!pool) return nullptr;
+  auto block = pool->blocks[pc >> 2 & 0x3f];
+  if(!block) return nullptr;
+  link(site, pc, block);
+  return block->code;
+}
+
+//patches the first free cache entry of a block exit to jump to block when the program counter is pc.
+auto CPU::Recompiler::link(u8* site, u32 pc, Block* block) -> void {
+  if(allocator.available() < 64_KiB) return;  //leave room for emit() to flush the allocator
+  for(u32 n : range(Entries)) {
+    auto entry = site + n * EntrySize;
+    if(memory::readl<4, u32>(entry + 7)) continue;
+    memory::writel<4>(entry + 1, pc);
+    memory::writel<4>(entry + 7, u32(block->code - (entry + EntrySize)));
+    auto link = (Link*)allocator.acquire(sizeof(Link));
+    link->entry = entry;
+    link->next = block->links;
+    block->links = link;
+    return;
+  }
+}
+
+//restores the cache entries that jump to blocks in pool to their unlinked state.
+auto CPU::Recompiler::unlink(Pool* pool) -> void {
+  for(auto block : pool->blocks) {
+    if(!block) continue;
+    for(auto link = block->links; link; link = link->next) {
+      memory::writel<4>(link->entry + 1, 0);
+      memory::writel<4>(link->entry + 7, 0);
+    }
+    block->links = nullptr;
+  }
+}
+
+//drops the pool a store hit, and forgets the page once none of its pools hold code.
+auto CPU::Recompiler::evict(u32 address) -> void {
+  if(auto& pool = pools[address >> 8 & 0x1fffff]) {
+    unlink(pool);
+    pool = nullptr;
+  }
+  u32 page = address >> 12 & 0x1ffff;
+  for(u32 index : range(1 << 4)) {
+    if(pools[page << 4 | index]) return;
+  }
+  pages[page >> 6] &= ~(1ull << (page & 63));
+}
+
 auto CPU::Recompiler::emit(u32 address) -> Block* {
   if(unlikely(allocator.available() < 1_MiB)) {
     print("CPU allocator flush\n");
     allocator.release(bump_allocator::zero_fill);
     reset();
   }
+  if(unlikely(!enter)) emitStubs();
 
   auto block = (Block*)allocator.acquire(sizeof(Block));
   block->code = allocator.acquire();
+  block->links = nullptr;
   bind({block->code, allocator.available()});
-  push(rbx);
-  push(rbp);
-  push(r13);
-  if constexpr(ABI::Windows) {
-    push(rsi);
-    push(rdi);
-    sub(rsp, imm8(0x40));
-  }
-  mov(rbx, imm64(&self.ipu.r[0]));
-  mov(rbp, imm64(&self));
 
   address &= 0x1fff'ffff;
   bool hasBranched = 0;
+  exits.reset();
   while(true) {
     //shortcut: presume CPU is executing out of either CPU RAM or the BIOS area
     u32 instruction = address <= 0x007f'ffff ? cpu.ram.readWord(address) : bios.readWord(address);
@@ -41,18 +88,74 @@ auto CPU::Recompiler::emit(u32 address) -> Block* {
     address += 4;
     if(hasBranched || (address & 0xfc) == 0) break;  //block boundary
     hasBranched = branched;
-    test(rax, rax);
-    jz(imm8(ABI::Windows ? 11 : 5));
-    if constexpr(ABI::Windows) {
-      add(rsp, imm8(0x40));
-      pop(rdi);
-      pop(rsi);
-    }
-    pop(r13);
-    pop(rbp);
-    pop(rbx);
-    ret();
+    test(al, al);
+    jnz(imm32(0));
+    exits.append(size());
+  }
+  emitExit();
+
+  allocator.reserve(size());
+//print(hex(PC, 8L), " ", instructions, " ", size(), "\n");
+  return block;
+}
+
+//the shared entry, exit and dispatch trampolines.
+auto CPU::Recompiler::emitStubs() -> void {
+  enter = allocator.acquire();
+  bind({enter, allocator.available()});
+  push(rbx);
+  push(rbp);
+  push(r13);
+  if constexpr(ABI::Windows) {
+    push(rsi);
+    push(rdi);
+    sub(rsp, imm8(0x40));
   }
+  mov(rbx, imm64(&self.ipu.r[0]));
+  mov(rbp, imm64(&self));
+  if(fastmem) mov(r13, imm64(fastmem.base()));
+  if constexpr(ABI::SystemV) jmp(rdi);
+  if constexpr(ABI::Windows) jmp(rcx);
+
+  leave = amd64::emit.span.data();
+  emitReturn();
+
+  dispatcher = amd64::emit.span.data();
+  mov(rax, imm64(&Recompiler::dispatch));
+  if constexpr(ABI::SystemV) mov(rdi, imm64(this));
+  if constexpr(ABI::Windows) mov(rcx, imm64(this));
+  call(rax);
+  test(rax, rax);
+  jz(imm32(leave - (amd64::emit.span.data() + 6)));
+  jmp(rax);
+
+  allocator.reserve(size());
+}
+
+//leaves the block once ipu.pc holds the next instruction to execute.
+//linked blocks keep running until the clock budget expires.
+auto CPU::Recompiler::emitExit() -> void {
+  for(auto label : exits) {
+    memory::writel<4>(amd64::emit.origin.data() + label - 4, size() - label);
+  }
+  exits.reset();
+
+  mov(rax, mem64(&self.clock));
+  cmp(rax, imm32(Budget));
+  jge(imm32(leave - (amd64::emit.span.data() + 6)));
+  mov(eax, mem64(&self.ipu.pc));
+  auto site = amd64::emit.span.data();
+  for(u32 n : range(Entries)) {
+    cmp(eax, imm32(0));
+    jz(imm32(0));
+  }
+  assert(amd64::emit.span.data() - site == Entries * EntrySize);
+  if constexpr(ABI::SystemV) mov(rsi, imm64(site));
+  if constexpr(ABI::Windows) mov(rdx, imm64(site));
+  jmp(imm32(dispatcher - (amd64::emit.span.data() + 5)));
+}
+
+auto CPU::Recompiler::emitReturn() -> void {
   if constexpr(ABI::Windows) {
     add(rsp, imm8(0x40));
     pop(rdi);
@@ -62,10 +165,20 @@ auto CPU::Recompiler::emit(u32 address) -> Block* {
   pop(rbp);
   pop(rbx);
   ret();
+}
 
-  allocator.reserve(size());
-//print(hex(PC, 8L), " ", instructions, " ", size(), "\n");
-  return block;
+//step(clocks)
+auto CPU::Recompiler::emitStep(u32 clocks) -> void {
+  mov(rax, mem64(&self.clock));
+  add(rax, imm8(clocks));
+  mov(mem64(&self.clock), rax);
+}
+
+//points the rel8 displacement of the jump ending at label to the current position.
+auto CPU::Recompiler::resolve(u32 label) -> void {
+  u32 distance = size() - label;
+  assert(distance < 0x80);
+  amd64::emit.origin.data()[label - 1] = distance;
 }
 
 #define Sa  (instruction >>  6 & 31)
@@ -241,19 +354,13 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LB Rt,Rs,i16
   case 0x20: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LB);
+    emitLoad<Byte, 1>(instruction, &CPU::LB);
     return 0;
   }
 
   //LH Rt,Rs,i16
   case 0x21: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LH);
+    emitLoad<Half, 1>(instruction, &CPU::LH);
     return 0;
   }
 
@@ -268,28 +375,19 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //LW Rt,Rs,i16
   case 0x23: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LW);
+    emitLoad<Word, 1>(instruction, &CPU::LW);
     return 0;
   }
 
   //LBU Rt,Rs,i16
   case 0x24: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LBU);
+    emitLoad<Byte, 0>(instruction, &CPU::LBU);
     return 0;
   }
 
   //LHU Rt,Rs,i16
   case 0x25: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::LHU);
+    emitLoad<Half, 0>(instruction, &CPU::LHU);
     return 0;
   }
 
@@ -310,19 +408,13 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //SB Rt,Rs,i16
   case 0x28: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SB);
+    emitStore<Byte>(instruction, &CPU::SB);
     return 0;
   }
 
   //SH Rt,Rs,i16
   case 0x29: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SH);
+    emitStore<Half>(instruction, &CPU::SH);
     return 0;
   }
 
@@ -337,10 +429,7 @@ auto CPU::Recompiler::emitEXECUTE(u32 instruction) -> bool {
 
   //SW Rt,Rs,i16
   case 0x2b: {
-    lea(rsi, Rt);
-    lea(rdx, Rs);
-    mov(ecx, imm32(i16));
-    call(&CPU::SW);
+    emitStore<Word>(instruction, &CPU::SW);
     return 0;
   }
 
@@ -1100,6 +1189,108 @@ auto CPU::Recompiler::emitGTE(u32 instruction) -> bool {
   return 0;
 }
 
+//RAM accesses go straight through the fastmem region when it is available.
+//the interpreter handles accesses with the cache isolated, and any address that is not RAM:
+//those fault on the first access, and the access jumps to the interpreter call from then on.
+template<u32 Size, bool Signed>
+auto CPU::Recompiler::emitLoad(u32 instruction, void (CPU::*function)(u32&, cu32&, s16)) -> void {
+  u32 resume = 0;
+  if(fastmem) {
+    mov(al, mem64(&self.scc.status.cache.isolate));
+    test(al, al);
+    jnz(imm8(0));
+    auto isolated = size();
+    mov(eax, Rs);
+    add(eax, imm32(i16));
+    if constexpr(Size == Half) and(eax, imm32(~1));
+    if constexpr(Size == Word) and(eax, imm32(~3));
+    auto access = amd64::emit.span.data();
+    if constexpr(Size == Byte &&  Signed) movsxb(edx, idx(r13, rax));
+    if constexpr(Size == Byte && !Signed) movzxb(edx, idx(r13, rax));
+    if constexpr(Size == Half &&  Signed) movsxw(edx, idx(r13, rax));
+    if constexpr(Size == Half && !Signed) movzxw(edx, idx(r13, rax));
+    if constexpr(Size == Word) mov(edx, idx(r13, rax));
+    assert(amd64::emit.span.data() - access >= 5);
+    emitStep(4);
+
+    //load(rt, data)
+    lea(rcx, Rt);
+    mov(rax, mem64(&self.delay.load[0].target));
+    cmp(rax, rcx);
+    jnz(imm8(0));
+    auto pending = size();
+    xor(eax, eax);
+    mov(mem64(&self.delay.load[0].target), rax);
+    resolve(pending);
+    mov(rax, rcx);
+    mov(mem64(&self.delay.load[1].target), rax);
+    mov(eax, edx);
+    mov(mem64(&self.delay.load[1].source), eax);
+
+    jmp(imm8(0));
+    resume = size();
+    resolve(isolated);
+    fastmem.recover(access, amd64::emit.span.data());
+  }
+  lea(rsi, Rt);
+  lea(rdx, Rs);
+  mov(ecx, imm32(i16));
+  call(function);
+  if(resume) resolve(resume);
+}
+
+template<u32 Size>
+auto CPU::Recompiler::emitStore(u32 instruction, void (CPU::*function)(cu32&, cu32&, s16)) -> void {
+  u32 resume = 0;
+  if(fastmem) {
+    mov(al, mem64(&self.scc.status.cache.isolate));
+    test(al, al);
+    jnz(imm8(0));
+    auto isolated = size();
+    mov(eax, Rs);
+    add(eax, imm32(i16));
+    if constexpr(Size == Half) and(eax, imm32(~1));
+    if constexpr(Size == Word) and(eax, imm32(~3));
+    mov(edx, Rt);
+    auto access = amd64::emit.span.data();
+    if constexpr(Size == Byte) mov(idx(r13, rax), dl);
+    if constexpr(Size == Half) mov(idx(r13, rax), dx);
+    if constexpr(Size == Word) mov(idx(r13, rax), edx);
+    assert(amd64::emit.span.data() - access >= 5);
+
+    //invalidate(address)
+    mov(ecx, eax);
+    shr(ecx, imm8(12));
+    and(ecx, imm32(0x1ffff));
+    mov(rdx, imm64(&pages[0]));
+    bt(dis(rdx), rcx);
+    jae(imm8(0));
+    auto clean = size();
+    if constexpr(ABI::SystemV) {
+      mov(esi, eax);
+      mov(rdi, imm64(this));
+    }
+    if constexpr(ABI::Windows) {
+      mov(edx, eax);
+      mov(rcx, imm64(this));
+    }
+    mov(rax, imm64(&Recompiler::evict));
+    call(rax);
+    resolve(clean);
+    emitStep(4);
+
+    jmp(imm8(0));
+    resume = size();
+    resolve(isolated);
+    fastmem.recover(access, amd64::emit.span.data());
+  }
+  lea(rsi, Rt);
+  lea(rdx, Rs);
+  mov(ecx, imm32(i16));
+  call(function);
+  if(resume) resolve(resume);
+}
+
 #undef Sa
 #undef Rdn
 #undef Rtn
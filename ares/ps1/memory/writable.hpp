@@ -1,7 +1,8 @@
 struct Writable : Interface {
   auto reset() -> void {
-    delete[] data;
+    if(owner) delete[] data;
     data = nullptr;
+    owner = true;
     size = 0;
     maskByte = 0;
     maskHalf = 0;
@@ -19,6 +20,20 @@ struct Writable : Interface {
     fill(fillWith);
   }
 
+  //uses memory provided by the caller (eg a fastmem backing store) instead of allocating it.
+  //the caller releases it after reset().
+  auto allocate(u32 capacity, u8* memory, u32 fillWith = ~0) -> void {
+    reset();
+    size = capacity & ~3;
+    u32 mask = bit::round(size) - 1;
+    maskByte = mask & ~0;
+    maskHalf = mask & ~1;
+    maskWord = mask & ~3;
+    data = memory;
+    owner = false;
+    fill(fillWith);
+  }
+
   auto fill(u32 value = 0) -> void {
     for(u32 address = 0; address < size; address += 4) {
       *(u32*)&data[address & maskWord] = value;
@@ -60,4 +75,5 @@ struct Writable : Interface {
   u32 maskByte = 0;
   u32 maskHalf = 0;
   u32 maskWord = 0;
+  bool owner = true;
 };
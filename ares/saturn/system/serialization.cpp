@@ -27,7 +27,7 @@ auto System::unserialize(serializer& s) -> bool {
   s(description);
 
   if(signature != SerializerSignature) return false;
-  if(string{version} != SerializerVersion) return false;
+  if(string{version} != SerializerVersion && string{version} != SerializerVersionCompatible && string{version} != SerializerVersionFullStack) return false;
 
   if(synchronize) power(/* reset =*/ false);
   serialize(s, synchronize);
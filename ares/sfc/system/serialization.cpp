@@ -28,7 +28,8 @@ auto System::unserialize(serializer& s) -> bool {
   s(description);
 
   if(signature != SerializerSignature) return false;
-  if(string{version} != SerializerVersion) return false;
+  if(string{version} != SerializerVersion && string{version} != SerializerVersionCompatible && string{version} != SerializerVersionFullStack) return false;
+  scheduler.setFullStack(string{version} == SerializerVersionFullStack);
 
   if(synchronize) power(/* reset = */ false);
   serialize(s, synchronize);
@@ -0,0 +1,90 @@
+#include <ares/ares.hpp>
+#include <mia/mia.hpp>
+
+namespace ares::ColecoVision   { auto load(Node::System& node, string name) -> bool; }
+namespace ares::Famicom        { auto load(Node::System& node, string name) -> bool; }
+namespace ares::GameBoy        { auto load(Node::System& node, string name) -> bool; }
+namespace ares::GameBoyAdvance { auto load(Node::System& node, string name) -> bool; }
+namespace ares::MasterSystem   { auto load(Node::System& node, string name) -> bool; }
+namespace ares::MegaDrive      { auto load(Node::System& node, string name) -> bool; }
+namespace ares::MSX            { auto load(Node::System& node, string name) -> bool; }
+namespace ares::NeoGeoPocket   { auto load(Node::System& node, string name) -> bool; }
+namespace ares::Nintendo64     { auto load(Node::System& node, string name) -> bool; }
+namespace ares::PCEngine       { auto load(Node::System& node, string name) -> bool; }
+namespace ares::PlayStation    { auto load(Node::System& node, string name) -> bool; }
+namespace ares::SG1000         { auto load(Node::System& node, string name) -> bool; }
+namespace ares::SuperFamicom   { auto load(Node::System& node, string name) -> bool; }
+namespace ares::WonderSwan     { auto load(Node::System& node, string name) -> bool; }
+
+struct Benchmark : ares::Platform {
+  struct Core {
+    string name;      //mia system name
+    string system;    //ares system name
+    u32 firmware;     //size of the (blank) firmware image required, if any
+    function<bool (ares::Node::System&, string)> load;
+  };
+
+  auto main(Arguments arguments) -> void;
+  auto serializer(Arguments arguments) -> void;
+  auto cartridge(string name) -> vector<u8>;
+  auto callable() -> void;
+  auto resampler() -> void;
+
+  //ares::Platform
+  auto pak(ares::Node::Object) -> shared_pointer<vfs::directory> override;
+  auto audio(ares::Node::Audio::Stream) -> void override;
+
+private:
+  //runs test() repeatedly for at least the given duration; returns the average time per call in seconds.
+  template<typename T> static auto measure(f64 duration, T test) -> f64;
+  //forces value to be materialized in memory, so that the compiler cannot elide or devirtualize its use.
+  template<typename T> static auto escape(T& value) -> void { asm volatile("" : : "r"(&value) : "memory"); }
+
+  vector<Core> cores;
+  shared_pointer<mia::Pak> system;
+  shared_pointer<mia::Pak> game;
+};
+
+template<typename T> auto Benchmark::measure(f64 duration, T test) -> f64 {
+  u64 iterations = 0;
+  u64 start = chrono::nanosecond(), end;
+  do {
+    test();
+    iterations++;
+  } while((end = chrono::nanosecond()) - start < duration * 1'000'000'000.0);
+  return (end - start) / 1'000'000'000.0 / iterations;
+}
+
+auto Benchmark::main(Arguments arguments) -> void {
+  string command = arguments.take();
+  if(command == "serializer") return serializer(arguments);
+  if(command == "function") return callable();
+  if(command == "resampler") return resampler();
+  print("usage: benchmark serializer [system ...]\n");
+  print("       benchmark function\n");
+  print("       benchmark resampler\n");
+}
+
+#include "serializer.cpp"
+#include "function.cpp"
+#include "resampler.cpp"
+
+auto Benchmark::pak(ares::Node::Object node) -> shared_pointer<vfs::directory> {
+  if(node->is<ares::Node::System>()) return system->pak;
+  if(game) return game->pak;
+  return {};
+}
+
+auto Benchmark::audio(ares::Node::Audio::Stream stream) -> void {
+  f64 samples[8];
+  while(stream->pending()) stream->read(samples);
+}
+
+#include <nall/main.hpp>
+auto nall::main(Arguments arguments) -> void {
+  mia::construct();
+  Benchmark benchmark;
+  ares::platform = &benchmark;
+  benchmark.main(arguments);
+  ares::platform = nullptr;
+}
@@ -0,0 +1,121 @@
+//the nall::function implementation prior to inline storage: every callable is heap allocated
+//inside a virtual container.
+namespace legacy {
+
+template<typename T> struct function;
+
+template<typename R, typename... P> struct function<auto (P...) -> R> {
+  template<typename L> struct is_compatible {
+    template<typename T> static auto exists(T*) -> const typename is_same<R, decltype(declval<T>().operator()(declval<P>()...))>::type;
+    template<typename T> static auto exists(...) -> const false_type;
+    static constexpr bool value = decltype(exists<L>(0))::value;
+  };
+
+  function() {}
+  function(const function& source) { operator=(source); }
+  function(auto (*function)(P...) -> R) { callback = new global(function); }
+  template<typename C> function(auto (C::*function)(P...) -> R, C* object) { callback = new member<C>(function, object); }
+  template<typename L, typename = enable_if_t<is_compatible<L>::value>> function(const L& object) { callback = new lambda<L>(object); }
+  ~function() { if(callback) delete callback; }
+
+  explicit operator bool() const { return callback; }
+  auto operator()(P... p) const -> R { return (*callback)(forward<P>(p)...); }
+
+  auto operator=(const function& source) -> function& {
+    if(this != &source) {
+      if(callback) { delete callback; callback = nullptr; }
+      if(source.callback) callback = source.callback->copy();
+    }
+    return *this;
+  }
+
+private:
+  struct container {
+    virtual auto operator()(P... p) const -> R = 0;
+    virtual auto copy() const -> container* = 0;
+    virtual ~container() = default;
+  };
+
+  container* callback = nullptr;
+
+  struct global : container {
+    auto (*function)(P...) -> R;
+    auto operator()(P... p) const -> R { return function(forward<P>(p)...); }
+    auto copy() const -> container* { return new global(function); }
+    global(auto (*function)(P...) -> R) : function(function) {}
+  };
+
+  template<typename C> struct member : container {
+    auto (C::*function)(P...) -> R;
+    C* object;
+    auto operator()(P... p) const -> R { return (object->*function)(forward<P>(p)...); }
+    auto copy() const -> container* { return new member(function, object); }
+    member(auto (C::*function)(P...) -> R, C* object) : function(function), object(object) {}
+  };
+
+  template<typename L> struct lambda : container {
+    mutable L object;
+    auto operator()(P... p) const -> R { return object(forward<P>(p)...); }
+    auto copy() const -> container* { return new lambda(object); }
+    lambda(const L& object) : object(object) {}
+  };
+};
+
+}
+
+namespace Callables {
+  struct Counter {
+    auto add(u32 value) -> u32 { return total += value; }
+    u32 total = 0;
+  };
+
+  static u32 total = 0;
+  static auto add(u32 value) -> u32 { return total += value; }
+}
+
+//measures construction, copying and invocation of nall::function against the legacy implementation,
+//for each kind of callable that ares binds: function pointers, member functions and lambdas.
+auto Benchmark::callable() -> void {
+  using namespace Callables;
+  Counter counter;
+  u32 captures[16] = {};
+
+  print("callable         operation      legacy ns   current ns   speedup\n");
+
+  auto report = [&](string callable, string operation, f64 before, f64 after) {
+    print(pad(callable, -16), " ", pad(operation, -12), " ");
+    print(pad(string{(u32)(before * 1e10) / 10.0}, 11), " ", pad(string{(u32)(after * 1e10) / 10.0}, 12), " ");
+    print(pad(string{(u32)(before / after * 100.0) / 100.0, "x"}, 9), "\n");
+  };
+
+  //each callable is passed as a pair of factories, so that construction from the callable itself is timed.
+  auto test = [&](string callable, auto makeLegacy, auto makeCurrent) {
+    //invocations go through an array of callables so that the compiler cannot resolve the targets.
+    //the array is kept small enough for both layouts to stay in the L1 cache.
+    static constexpr u32 Size = 64;
+    vector<legacy::function<auto (u32) -> u32>> legacyArray;
+    vector<nall::function<auto (u32) -> u32>> currentArray;
+    for(u32 n : range(Size)) legacyArray.append(makeLegacy()), currentArray.append(makeCurrent());
+
+    f64 before = measure(0.25, [&] { for(auto& f : legacyArray) f(1); }) / Size;
+    f64 after  = measure(0.25, [&] { for(auto& f : currentArray) f(1); }) / Size;
+    report(callable, "invoke", before, after);
+
+    before = measure(0.25, [&] { for(u32 n : range(Size)) { auto f = makeLegacy(); escape(f); f(1); } }) / Size;
+    after  = measure(0.25, [&] { for(u32 n : range(Size)) { auto f = makeCurrent(); escape(f); f(1); } }) / Size;
+    report(callable, "construct", before, after);
+
+    before = measure(0.25, [&] { for(u32 n : range(Size)) legacyArray[n] = legacyArray[Size - 1 - n]; }) / Size;
+    after  = measure(0.25, [&] { for(u32 n : range(Size)) currentArray[n] = currentArray[Size - 1 - n]; }) / Size;
+    report(callable, "copy", before, after);
+  };
+
+  using Legacy = legacy::function<auto (u32) -> u32>;
+  using Current = nall::function<auto (u32) -> u32>;
+  auto small = [&counter](u32 value) -> u32 { return counter.total += value; };
+  auto large = [captures](u32 value) mutable -> u32 { return captures[value & 15] += value; };
+  test("function",     [&] { return Legacy{add}; }, [&] { return Current{add}; });
+  test("member",       [&] { return Legacy{&Counter::add, &counter}; }, [&] { return Current{&Counter::add, &counter}; });
+  test("small lambda", [&] { return Legacy{small}; }, [&] { return Current{small}; });
+  test("large lambda", [&] { return Legacy{large}; }, [&] { return Current{large}; });
+}
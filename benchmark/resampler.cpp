@@ -0,0 +1,45 @@
+//measures the host time needed to resample one second of audio, for each stream that uses the sinc resampler.
+//the same input is also run through the cubic resampler and the Nyquist biquad cascade that it uses for decimation.
+auto Benchmark::resampler() -> void {
+  struct Source {
+    string name;
+    f64 frequency;
+    u32 channels;
+  };
+  vector<Source> sources;
+  sources.append({"Game Boy APU", 2.0 * 1024 * 1024, 2});
+  sources.append({"SN76489",      3'579'545.0 / 16.0, 1});
+  sources.append({"YM2612",       53'693'175.0 / 7.0 / 144.0, 2});
+
+  print("stream         input Hz   channels   sinc ms/s   cubic ms/s\n");
+
+  auto root = ares::Node::System::create("Benchmark");
+  for(auto& source : sources) {
+    ares::Node::Audio::Stream stream = root->append<ares::Node::Audio::Stream>(source.name);
+    stream->setChannels(source.channels);
+    stream->setFrequency(source.frequency);
+
+    //one second of noise, written in the ~1ms blocks that Stream::frame() batches.
+    u32 frames = source.frequency;
+    u32 block = max(1.0, source.frequency / 1000.0);
+    vector<f64> input;
+    input.resize(frames * source.channels);
+    u32 seed = 1;
+    for(auto& sample : input) sample = ((seed = seed * 1103515245 + 12345) >> 16 & 0x7fff) / 32768.0 - 0.5;
+
+    auto test = [&](ares::Node::Audio::Resampler resampler) -> f64 {
+      stream->setResampler(resampler);
+      return measure(1.0, [&] {
+        for(u32 offset = 0; offset < frames; offset += block) {
+          stream->write(input.data() + offset * source.channels, min(block, frames - offset));
+        }
+      });
+    };
+    f64 sinc = test(ares::Node::Audio::Resampler::Sinc);
+    f64 cubic = test(ares::Node::Audio::Resampler::Cubic);
+
+    print(pad(source.name, -14), " ", pad((u32)source.frequency, 8), " ", pad(source.channels, 10), " ");
+    print(pad(string{(u32)(sinc * 1e5) / 100.0}, 11), " ", pad(string{(u32)(cubic * 1e5) / 100.0}, 12), "\n");
+    root->remove(stream);
+  }
+}
@@ -0,0 +1,86 @@
+//measures save state and load state throughput of each core.
+//systems run without a cartridge (and with blank firmware where one is required),
+//which still produces full-sized states: every core serializes all of its memories.
+auto Benchmark::serializer(Arguments arguments) -> void {
+  cores.append({"ColecoVision",     "[Coleco] ColecoVision (NTSC)",          8_KiB, ares::ColecoVision::load});
+  cores.append({"Famicom",          "[Nintendo] Famicom (NTSC-U)",               0, ares::Famicom::load});
+  cores.append({"Game Boy Color",   "[Nintendo] Game Boy Color",                 0, ares::GameBoy::load});
+  cores.append({"Game Boy Advance", "[Nintendo] Game Boy Advance",        16_KiB, ares::GameBoyAdvance::load});
+  cores.append({"Master System",    "[Sega] Master System (NTSC-U)",             0, ares::MasterSystem::load});
+  cores.append({"Mega Drive",       "[Sega] Mega Drive (NTSC-U)",                0, ares::MegaDrive::load});
+  cores.append({"MSX2",             "[Microsoft] MSX2 (NTSC)",                   0, ares::MSX::load});
+  cores.append({"Neo Geo Pocket Color", "[SNK] Neo Geo Pocket Color",     64_KiB, ares::NeoGeoPocket::load});
+  cores.append({"Nintendo 64",      "[Nintendo] Nintendo 64 (NTSC)"  ,           0, ares::Nintendo64::load});
+  cores.append({"PC Engine",        "[NEC] PC Engine (NTSC-J)",                  0, ares::PCEngine::load});
+  cores.append({"PlayStation",      "[Sony] PlayStation (NTSC-U)",         512_KiB, ares::PlayStation::load});
+  cores.append({"SG-1000",          "[Sega] SG-1000 (NTSC)"  ,                   0, ares::SG1000::load});
+  cores.append({"Super Famicom",    "[Nintendo] Super Famicom (NTSC)",           0, ares::SuperFamicom::load});
+  cores.append({"WonderSwan Color", "[Bandai] WonderSwan Color",                 0, ares::WonderSwan::load});
+
+  string firmware = {Path::temporary(), "benchmark-firmware.rom"};
+  string image = {Path::temporary(), "benchmark-cartridge.rom"};
+  print("system                 state size     save/s     load/s   save MB/s   load MB/s\n");
+
+  for(auto& core : cores) {
+    if(arguments && !arguments.find(core.name)) continue;
+
+    vector<u8> blank;
+    blank.resize(core.firmware ? core.firmware : 1);
+    file::write(firmware, blank);
+    system = mia::System::create(core.name);
+    if(!system->load(firmware)) { print(pad(core.name, -22), " failed to load system\n"); continue; }
+
+    if(auto rom = cartridge(core.name)) {
+      file::write(image, rom);
+      game = mia::Medium::create(core.name);
+      if(!game->load(image)) { print(pad(core.name, -22), " failed to load cartridge\n"); continue; }
+    }
+
+    ares::Node::System root;
+    if(!core.load(root, core.system)) { print(pad(core.name, -22), " failed to load core\n"); continue; }
+    if(auto port = root->find<ares::Node::Port>("Cartridge Slot"); port && game) {
+      port->allocate();
+      port->connect();
+    }
+    root->power();
+    for(u32 frame : range(10)) root->run();
+
+    //serialize(false) skips thread synchronization, so that only the state transfer itself is timed.
+    auto state = root->serialize(false);
+    u32 size = state.size();
+    f64 save = measure(0.5, [&] { root->serialize(false); });
+    f64 load = measure(0.5, [&] {
+      ::serializer s{state.data(), size};
+      root->unserialize(s);
+    });
+
+    print(pad(core.name, -22), " ", pad(size, 10), " ");
+    print(pad((u32)(1.0 / save), 10), " ", pad((u32)(1.0 / load), 10), " ");
+    print(pad((u32)(size / save / 1'000'000.0), 11), " ");
+    print(pad((u32)(size / load / 1'000'000.0), 11), "\n");
+
+    root->unload();
+    root.reset();
+    system.reset();
+    game.reset();
+  }
+
+  file::remove(firmware);
+  file::remove(image);
+}
+
+//returns a blank cartridge image for cores that cannot run without one.
+auto Benchmark::cartridge(string name) -> vector<u8> {
+  vector<u8> rom;
+  if(name == "Famicom") {
+    //iNES NROM: 16KiB program ROM, 8KiB character ROM
+    rom.resize(16 + 16_KiB + 8_KiB);
+    rom[0] = 'N', rom[1] = 'E', rom[2] = 'S', rom[3] = 0x1a, rom[4] = 1, rom[5] = 1;
+  }
+  if(name == "Nintendo 64") {
+    //big-endian (.z64) image
+    rom.resize(1_MiB);
+    rom[0] = 0x80, rom[1] = 0x37, rom[2] = 0x12, rom[3] = 0x40;
+  }
+  return rom;
+}
@@ -45,12 +45,18 @@ Nintendo64::Nintendo64() {
 auto Nintendo64::load() -> bool {
   game = mia::Medium::create("Nintendo 64");
   if(!game->load(Emulator::load(game, configuration.game))) return false;
+  if(settings.general.recompilerCache) {
+    game->pak->append("recompiler.cache", 64_KiB);
+    game->load("recompiler.cache", ".rcache");
+  }
 
   system = mia::System::create("Nintendo 64");
   if(!system->load()) return false;
 
   ares::Nintendo64::option("Quality", settings.video.quality);
   ares::Nintendo64::option("Supersampling", settings.video.supersampling);
+  ares::Nintendo64::option("Threaded RSP", settings.general.threadedRSP);
+  ares::Nintendo64::option("Threaded VI", settings.general.threadedVI);
 
   auto region = Emulator::region();
   if(!ares::Nintendo64::load(root, {"[Nintendo] Nintendo 64 (", region, ")"})) return false;
@@ -90,6 +96,7 @@ auto Nintendo64::save() -> bool {
   root->save();
   system->save(system->location);
   game->save(game->location);
+  game->save("recompiler.cache", ".rcache");
   if(gamepad) gamepad->save("save.pak", ".pak", game->location);
   return true;
 }
@@ -58,6 +58,8 @@ auto Nintendo64DD::load() -> bool {
 
   ares::Nintendo64::option("Quality", settings.video.quality);
   ares::Nintendo64::option("Supersampling", settings.video.supersampling);
+  ares::Nintendo64::option("Threaded RSP", settings.general.threadedRSP);
+  ares::Nintendo64::option("Threaded VI", settings.general.threadedVI);
 
   auto region = Emulator::region();
   if(!ares::Nintendo64::load(root, {"[Nintendo] Nintendo 64 (", region, ")"})) return false;
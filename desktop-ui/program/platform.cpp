@@ -116,39 +116,46 @@ auto Program::video(ares::Node::Video::Screen node, const u32* data, u32 pitch,
 auto Program::audio(ares::Node::Audio::Stream node) -> void {
   if(!streams) return;
 
-  //process all pending frames (there may be more than one waiting)
-  while(true) {
-    //only process a frame if all streams have at least one pending frame
-    for(auto& stream : streams) {
-      if(!stream->pending()) return;
-    }
-
-    //mix all frames together
-    f64 samples[2] = {0.0, 0.0};
-    for(auto& stream : streams) {
-      f64 buffer[2];
-      u32 channels = stream->read(buffer);
-      if(channels == 1) {
-        //monaural -> stereo mixing
-        samples[0] += buffer[0];
-        samples[1] += buffer[0];
-      } else {
-        samples[0] += buffer[0];
-        samples[1] += buffer[1];
+  //only mix frames that every stream has pending (there may be many waiting)
+  u32 frames = ~0u;
+  for(auto& stream : streams) frames = min(frames, stream->available());
+  if(!frames) return;
+
+  //mix all frames together
+  static vector<f64> samples, buffer;
+  samples.resize(0);
+  samples.resize(frames * 2);
+  for(auto& stream : streams) {
+    u32 channels = stream->channels();
+    buffer.resize(frames * channels);
+    stream->read(buffer.data(), frames);
+    if(channels == 1) {
+      //monaural -> stereo mixing
+      for(u32 n : range(frames)) {
+        samples[n * 2 + 0] += buffer[n];
+        samples[n * 2 + 1] += buffer[n];
+      }
+    } else {
+      for(u32 n : range(frames)) {
+        samples[n * 2 + 0] += buffer[n * channels + 0];
+        samples[n * 2 + 1] += buffer[n * channels + 1];
       }
     }
+  }
 
-    //apply volume, balance, and clamping to the output frame
-    f64 volume = !settings.audio.mute ? settings.audio.volume : 0.0;
-    f64 balance = settings.audio.balance;
+  //apply volume, balance, and clamping to each output frame
+  f64 volume = !settings.audio.mute ? settings.audio.volume : 0.0;
+  f64 balance = settings.audio.balance;
+  for(u32 n : range(frames)) {
+    auto frame = samples.data() + n * 2;
     for(u32 c : range(2)) {
-      samples[c] = max(-1.0, min(+1.0, samples[c] * volume));
-      if(balance < 0.0) samples[1] *= 1.0 + balance;
-      if(balance > 0.0) samples[0] *= 1.0 - balance;
+      frame[c] = max(-1.0, min(+1.0, frame[c] * volume));
+      if(balance < 0.0) frame[1] *= 1.0 + balance;
+      if(balance > 0.0) frame[0] *= 1.0 - balance;
     }
 
     //send frame to the audio output device
-    ruby::audio.output(samples);
+    ruby::audio.output(frame);
   }
 }
 
@@ -11,6 +11,7 @@ Program program;
 
 auto Program::create() -> void {
   ares::platform = this;
+  rewindCreate();
 
   videoDriverUpdate();
   audioDriverUpdate();
@@ -83,6 +84,7 @@ auto Program::main() -> void {
 
 auto Program::quit() -> void {
   unload();
+  rewindDestroy();
   presentation.setVisible(false);  //makes quitting the emulator feel more responsive
   Application::processEvents();
   Application::quit();
@@ -66,14 +66,31 @@ struct Program : ares::Platform {
   //rewind.cpp
   struct Rewind {
     enum class Mode : u32 { Playing, Rewinding } mode = Mode::Playing;
-    vector<serializer> history;
-    u32 length = 0;
+    struct Snapshot {
+      vector<u8> data;  //delta against the next newer state, or the state itself for keyframes
+      bool keyframe = false;
+    };
+    vector<Snapshot> history;  //oldest first; the newest state is held uncompressed in current
+    vector<u8> current;
+    maybe<serializer> pending;  //captured by the emulation thread, awaiting compression
+    u64 memory = 0;  //bytes held by history and current
+    u64 budget = 0;  //bytes
     u32 frequency = 0;
     u32 counter = 0;
+
+    nall::thread worker;
+    nall::mutex lock;
+    nall::condition_variable condition;
+    bool busy = false;
+    bool quit = false;
   } rewind;
   auto rewindSetMode(Rewind::Mode) -> void;
   auto rewindReset() -> void;
   auto rewindRun() -> void;
+  auto rewindCreate() -> void;
+  auto rewindDestroy() -> void;
+  auto rewindWorker(uintptr) -> void;
+  auto rewindWait(nall::unique_lock<nall::mutex>&) -> void;
 
   struct Message {
     u64 timestamp = 0;
@@ -1,3 +1,54 @@
+//the rewind history is a chain of reverse deltas: the newest state is held uncompressed in
+//rewind.current, and each older state is stored as the XOR against the state that followed it,
+//with runs of unchanged bytes omitted. stepping backward applies the newest delta to current.
+//compression happens on a worker thread; the emulation thread only hands off the serializer.
+
+//encodes source ^ target as a series of {u32 unchanged, u32 changed, u8 xor[changed]} runs.
+static auto rewindEncode(vector<u8>& output, const u8* source, const u8* target, u32 size) -> void {
+  //a changed run only ends once at least eight unchanged bytes follow it.
+  auto equal = [&](u32 offset) -> bool {
+    return offset + 8 <= size && memory::readl<8>(source + offset) == memory::readl<8>(target + offset);
+  };
+
+  u32 length = 0;
+  u32 offset = 0;
+  output.reallocate(0);
+  while(offset < size) {
+    u32 start = offset;
+    while(equal(offset)) offset += 8;
+    while(offset < size && source[offset] == target[offset]) offset++;
+    u32 unchanged = offset - start;
+
+    start = offset;
+    while(offset < size && !equal(offset)) offset++;
+    u32 changed = offset - start;
+
+    output.reallocate(length + 8 + changed);
+    auto p = output.data() + length;
+    memory::writel<4>(p + 0, unchanged);
+    memory::writel<4>(p + 4, changed);
+    for(u32 n : range(changed)) p[8 + n] = source[start + n] ^ target[start + n];
+    length += 8 + changed;
+  }
+}
+
+//applies an encoded delta to target in place.
+static auto rewindDecode(const vector<u8>& input, u8* target, u32 size) -> void {
+  auto p = input.data();
+  auto end = p + input.size();
+  u32 offset = 0;
+  while(p + 8 <= end) {
+    u32 unchanged = memory::readl<4, u32>(p + 0);
+    u32 changed = memory::readl<4, u32>(p + 4);
+    p += 8;
+    offset += unchanged;
+    if(offset + changed > size || p + changed > end) break;  //corrupt delta
+    for(u32 n : range(changed)) target[offset + n] ^= p[n];
+    offset += changed;
+    p += changed;
+  }
+}
+
 auto Program::rewindSetMode(Rewind::Mode mode) -> void {
   rewind.mode = mode;
   rewind.counter = 0;
@@ -5,8 +56,12 @@ auto Program::rewindSetMode(Rewind::Mode mode) -> void {
 
 auto Program::rewindReset() -> void {
   rewindSetMode(Rewind::Mode::Playing);
+  unique_lock<mutex> lock(rewind.lock);
+  rewindWait(lock);
   rewind.history.reset();
-  rewind.length = settings.rewind.length;
+  rewind.current.reset();
+  rewind.memory = 0;
+  rewind.budget = (u64)settings.rewind.memory * 1_MiB;
   rewind.frequency = settings.rewind.frequency;
 }
 
@@ -16,21 +71,95 @@ auto Program::rewindRun() -> void {
   if(rewind.mode == Rewind::Mode::Playing) {
     if(++rewind.counter < rewind.frequency) return;
     rewind.counter = 0;
-    if(rewind.history.size() >= rewind.length) rewind.history.takeFirst();
     auto s = emulator->root->serialize(0);
-    rewind.history.append(s);
+    lock_guard<mutex> lock(rewind.lock);
+    //if the worker has fallen behind, the older pending state is simply skipped.
+    rewind.pending = move(s);
+    rewind.condition.notify_one();
   }
 
   if(rewind.mode == Rewind::Mode::Rewinding) {
-    if(!rewind.history.size()) return rewindSetMode(Rewind::Mode::Playing);  //nothing left to rewind?
+    unique_lock<mutex> lock(rewind.lock);
+    rewindWait(lock);
+    if(!rewind.current) return rewindSetMode(Rewind::Mode::Playing);  //nothing left to rewind?
     if(++rewind.counter < rewind.frequency / 5) return;  //rewind 5x faster than playing
     rewind.counter = 0;
-    auto s = rewind.history.takeLast();
-    s.setReading();
+    serializer s{rewind.current.data(), (u32)rewind.current.size()};
     emulator->root->unserialize(s);
     if(!rewind.history) {
+      lock.unlock();
       showMessage("Rewind history exhausted");
-      rewindReset();
+      return rewindReset();
+    }
+    auto snapshot = rewind.history.takeLast();
+    rewind.memory -= snapshot.data.capacity() + rewind.current.capacity();
+    if(snapshot.keyframe) {
+      rewind.current = move(snapshot.data);
+    } else {
+      rewindDecode(snapshot.data, rewind.current.data(), rewind.current.size());
+    }
+    rewind.memory += rewind.current.capacity();
+  }
+}
+
+auto Program::rewindCreate() -> void {
+  rewind.quit = false;
+  rewind.worker = nall::thread::create({&Program::rewindWorker, this});
+}
+
+auto Program::rewindDestroy() -> void {
+  {
+    lock_guard<mutex> lock(rewind.lock);
+    rewind.quit = true;
+    rewind.condition.notify_one();
+  }
+  rewind.worker.join();
+}
+
+auto Program::rewindWorker(uintptr) -> void {
+  vector<u8> delta;
+  while(true) {
+    unique_lock<mutex> lock(rewind.lock);
+    rewind.condition.wait(lock, [&] { return rewind.quit || rewind.pending; });
+    if(rewind.quit) return;
+    auto state = move(rewind.pending());
+    rewind.pending.reset();
+    rewind.busy = true;
+    lock.unlock();
+
+    //the main thread does not touch current or history while busy is set.
+    Rewind::Snapshot snapshot;
+    u64 released = rewind.current.capacity();
+    bool append = (bool)rewind.current;
+    if(append && rewind.current.size() == state.size()) {
+      rewindEncode(delta, rewind.current.data(), state.data(), state.size());
+      snapshot.data.resize(delta.size());
+      memory::copy(snapshot.data.data(), delta.data(), delta.size());
+    } else if(append) {
+      //the state size changed (eg a different system configuration): store the state itself.
+      snapshot.data = move(rewind.current);
+      snapshot.keyframe = true;
+    }
+    rewind.current.resize(state.size());
+    memory::copy(rewind.current.data(), state.data(), state.size());
+
+    lock.lock();
+    rewind.memory += rewind.current.capacity();
+    rewind.memory -= released;
+    if(append) {
+      rewind.memory += snapshot.data.capacity();
+      rewind.history.append(move(snapshot));
     }
+    while(rewind.history && rewind.memory > rewind.budget) {
+      rewind.memory -= rewind.history.first().data.capacity();
+      rewind.history.removeFirst();
+    }
+    rewind.busy = false;
+    rewind.condition.notify_all();
   }
 }
+
+//waits for the worker thread to finish compressing any outstanding states.
+auto Program::rewindWait(unique_lock<mutex>& lock) -> void {
+  rewind.condition.wait(lock, [&] { return !rewind.busy && !rewind.pending; });
+}
@@ -25,4 +25,19 @@ auto OptionSettings::construct() -> void {
     settings.general.nativeFileDialogs = nativeFileDialogs.checked();
   });
   nativeFileDialogsHint.setText("More familiar, but lacks advanced loading options").setFont(Font().setSize(7.0)).setForegroundColor({80, 80, 80});
+
+  recompilerCache.setText("Recompiler Cache").setChecked(settings.general.recompilerCache).onToggle([&] {
+    settings.general.recompilerCache = recompilerCache.checked();
+  });
+  recompilerCacheHint.setText("Remembers translated code between runs to reduce stutter (Nintendo 64)").setFont(Font().setSize(7.0)).setForegroundColor({80, 80, 80});
+
+  threadedRSP.setText("Threaded RSP").setChecked(settings.general.threadedRSP).onToggle([&] {
+    settings.general.threadedRSP = threadedRSP.checked();
+  });
+  threadedRSPHint.setText("Runs the RSP on a second core; faster, but timing is no longer deterministic (Nintendo 64)").setFont(Font().setSize(7.0)).setForegroundColor({80, 80, 80});
+
+  threadedVI.setText("Threaded VI").setChecked(settings.general.threadedVI).onToggle([&] {
+    settings.general.threadedVI = threadedVI.checked();
+  });
+  threadedVIHint.setText("Converts frames on the video thread; faster, but may show partially drawn frames (Nintendo 64)").setFont(Font().setSize(7.0)).setForegroundColor({80, 80, 80});
 }
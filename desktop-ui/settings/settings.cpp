@@ -95,8 +95,11 @@ auto Settings::process(bool load) -> void {
   bind(boolean, "General/AutoSaveMemory", general.autoSaveMemory);
   bind(boolean, "General/NativeFileDialogs", general.nativeFileDialogs);
   bind(boolean, "General/GroupEmulators", general.groupEmulators);
+  bind(boolean, "General/RecompilerCache", general.recompilerCache);
+  bind(boolean, "General/ThreadedRSP", general.threadedRSP);
+  bind(boolean, "General/ThreadedVI", general.threadedVI);
 
-  bind(natural, "Rewind/Length", rewind.length);
+  bind(natural, "Rewind/Memory", rewind.memory);
   bind(natural, "Rewind/Frequency", rewind.frequency);
 
   bind(string,  "Paths/Home", paths.home);
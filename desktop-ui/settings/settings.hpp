@@ -63,10 +63,13 @@ struct Settings : Markup::Node {
     bool autoSaveMemory = true;
     bool nativeFileDialogs = true;
     bool groupEmulators = true;
+    bool recompilerCache = false;
+    bool threadedRSP = false;
+    bool threadedVI = false;
   } general;
 
   struct Rewind {
-    u32 length = 100;
+    u32 memory = 256;  //MiB
     u32 frequency = 10;
   } rewind;
 
@@ -224,6 +227,15 @@ struct OptionSettings : VerticalLayout {
   HorizontalLayout nativeFileDialogsLayout{this, Size{~0, 0}, 2};
     CheckLabel nativeFileDialogs{&nativeFileDialogsLayout, Size{0, 0}, 2};
     Label nativeFileDialogsHint{&nativeFileDialogsLayout, Size{~0, 0}};
+  HorizontalLayout recompilerCacheLayout{this, Size{~0, 0}, 2};
+    CheckLabel recompilerCache{&recompilerCacheLayout, Size{0, 0}, 2};
+    Label recompilerCacheHint{&recompilerCacheLayout, Size{~0, 0}};
+  HorizontalLayout threadedRSPLayout{this, Size{~0, 0}, 2};
+    CheckLabel threadedRSP{&threadedRSPLayout, Size{0, 0}, 2};
+    Label threadedRSPHint{&threadedRSPLayout, Size{~0, 0}};
+  HorizontalLayout threadedVILayout{this, Size{~0, 0}, 2};
+    CheckLabel threadedVI{&threadedVILayout, Size{0, 0}, 2};
+    Label threadedVIHint{&threadedVILayout, Size{~0, 0}};
 };
 
 struct FirmwareSettings : VerticalLayout {
@@ -25,6 +25,9 @@ struct bump_allocator {
     reset();
     _offset = 0;
     _capacity = capacity + 4095 & ~4095;              //capacity alignment
+    _base = 0;
+    _segment = _capacity;
+    _limit = _capacity;
     _memory = memory::allocate<u8, 4096>(_capacity);  //_SC_PAGESIZE alignment
     if(!_memory) return false;
 
@@ -47,22 +50,49 @@ struct bump_allocator {
   //release all acquired memory
   auto release(u32 flags = 0) -> void {
     _offset = 0;
+    _base = 0;
+    _segment = _capacity;
+    _limit = _capacity;
     if(flags & zero_fill) memset(_memory, 0x00, _capacity);
   }
 
+  //divides the memory after the current offset into count equally sized segments.
+  //acquisitions fill one segment at a time: advance() moves on to the next one.
+  auto partition(u32 count) -> void {
+    _base = _offset;
+    _segment = (_capacity - _base) / count & ~4095;
+    _limit = _base + _segment;
+  }
+
+  //moves to the start of the next segment, wrapping around to the first after the last.
+  //the caller must have discarded everything it acquired there the previous time around.
+  auto advance(u32 flags = 0) -> u32 {
+    if(_limit + _segment > _capacity) _limit = _base;
+    _offset = _limit;
+    _limit = _offset + _segment;
+    if(flags & zero_fill) memset(_memory + _offset, 0x00, _segment);
+    return segment();
+  }
+
+  //the index of the segment acquisitions are currently made from
+  auto segment() const -> u32 {
+    return (_offset - _base) / _segment;
+  }
+
   auto capacity() const -> u32 {
     return _capacity;
   }
 
+  //the memory left in the current segment
   auto available() const -> u32 {
-    return _capacity - _offset;
+    return _limit - _offset;
   }
 
   //for allocating blocks of known size
   auto acquire(u32 size) -> u8* {
     #ifdef DEBUG
     struct out_of_memory {};
-    if((_offset + size + 15 & ~15) > _capacity) throw out_of_memory{};
+    if((_offset + size + 15 & ~15) > _limit) throw out_of_memory{};
     #endif
     auto memory = _memory + _offset;
     _offset = _offset + size + 15 & ~15;  //alignment
@@ -73,7 +103,7 @@ struct bump_allocator {
   auto acquire() -> u8* {
     #ifdef DEBUG
     struct out_of_memory {};
-    if(_offset > _capacity) throw out_of_memory{};
+    if(_offset > _limit) throw out_of_memory{};
     #endif
     return _memory + _offset;
   }
@@ -82,7 +112,7 @@ struct bump_allocator {
   auto reserve(u32 size) -> void {
     #ifdef DEBUG
     struct out_of_memory {};
-    if((_offset + size + 15 & ~15) > _capacity) throw out_of_memory{};
+    if((_offset + size + 15 & ~15) > _limit) throw out_of_memory{};
     #endif
     _offset = _offset + size + 15 & ~15;  //alignment
   }
@@ -91,6 +121,9 @@ private:
   u8* _memory = nullptr;
   u32 _capacity = 0;
   u32 _offset = 0;
+  u32 _base = 0;     //start of the first segment
+  u32 _segment = 0;  //size of each segment
+  u32 _limit = 0;    //end of the current segment
 };
 
 }
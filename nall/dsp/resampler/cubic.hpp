@@ -12,8 +12,10 @@ struct Cubic {
   auto reset(f64 inputFrequency, f64 outputFrequency = 0, u32 queueSize = 0) -> void;
   auto setInputFrequency(f64 inputFrequency) -> void;
   auto pending() const -> bool;
+  auto size() const -> u32;
   auto read() -> f64;
   auto write(f64 sample) -> void;
+  auto write(const f64 samples[], u32 count) -> void;
   auto serialize(serializer&) -> void;
 
 private:
@@ -45,6 +47,10 @@ inline auto Cubic::pending() const -> bool {
   return _samples.pending();
 }
 
+inline auto Cubic::size() const -> u32 {
+  return _samples.size();
+}
+
 inline auto Cubic::read() -> double {
   return _samples.read();
 }
@@ -71,6 +77,10 @@ inline auto Cubic::write(f64 sample) -> void {
   mu -= 1.0;
 }
 
+inline auto Cubic::write(const f64 samples[], u32 count) -> void {
+  for(u32 n : range(count)) write(samples[n]);
+}
+
 inline auto Cubic::serialize(serializer& s) -> void {
   s(_inputFrequency);
   s(_outputFrequency);
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <nall/queue.hpp>
+#include <nall/serializer.hpp>
+#include <nall/vector.hpp>
+
+//polyphase windowed-sinc (Kaiser) resampler.
+//when decimating, the kernel is stretched so that it band-limits the input to the output Nyquist
+//frequency; sources running far above the output rate therefore need no separate anti-aliasing filter.
+//at high ratios, halfband stages first decimate the input by powers of two, so that the kernel stays short.
+
+namespace nall::DSP::Resampler {
+
+struct Sinc {
+  auto inputFrequency() const -> f64 { return _inputFrequency; }
+  auto outputFrequency() const -> f64 { return _outputFrequency; }
+
+  auto reset(f64 inputFrequency, f64 outputFrequency = 0, u32 queueSize = 0) -> void;
+  auto setInputFrequency(f64 inputFrequency) -> void;
+  auto pending() const -> bool;
+  auto size() const -> u32;
+  auto read() -> f64;
+  auto write(f64 sample) -> void;
+  auto write(const f64 samples[], u32 count) -> void;
+  auto serialize(serializer&) -> void;
+
+private:
+  static constexpr u32 Crossings = 16;  //zero crossings on each side of the kernel center
+  static constexpr f64 Cutoff = 0.91;   //passband edge, relative to the lower Nyquist frequency
+  static constexpr f64 Beta = 8.0;      //Kaiser window shape (~80dB stopband)
+  static constexpr u32 HalfbandTaps = 23;   //decimation stage length; only the center and odd taps are nonzero
+  static constexpr f64 HalfbandBeta = 9.0;  //~84dB stopband above 0.386 of the stage input rate
+
+  //decimate-by-two stage: the buffer holds the last HalfbandTaps - 1 inputs (plus one more when an
+  //odd number has been written), and new blocks are appended after them.
+  struct Halfband {
+    vector<f64> buffer;
+    u32 size;
+  };
+
+  static auto stages(f64 ratio) -> u32;
+  auto design() -> void;
+  auto resample(f64 sample) -> void;
+  auto convolve(const f32* coefficients, const f32* samples) const -> f64;
+  static auto bessel(f64 x) -> f64;
+
+  f64 _inputFrequency;
+  f64 _outputFrequency;
+
+  f64 _ratio;  //remaining ratio after the halfband stages
+  f64 _scale;  //kernel stretch the coefficients were designed for
+  f64 _fraction;
+  u32 _taps;
+  u32 _phases;
+  u32 _offset;
+  vector<f32> _coefficients;  //[_phases][_taps]
+  vector<f32> _history;       //the last _taps samples, stored twice so that every window is contiguous
+  f64 _halfband[HalfbandTaps / 4 + 1];  //odd taps, from the center outward
+  vector<Halfband> _stages;
+  vector<f64> _decimated;  //output of the halfband stages
+  queue<f64> _samples;
+};
+
+inline auto Sinc::reset(f64 inputFrequency, f64 outputFrequency, u32 queueSize) -> void {
+  _inputFrequency = inputFrequency;
+  _outputFrequency = outputFrequency ? outputFrequency : _inputFrequency;
+  design();
+  _samples.resize(queueSize ? queueSize : _outputFrequency * 0.02);  //default to 20ms max queue size
+}
+
+inline auto Sinc::setInputFrequency(f64 inputFrequency) -> void {
+  _inputFrequency = inputFrequency;
+  f64 ratio = _inputFrequency / _outputFrequency;
+  _ratio = ratio / (1 << _stages.size());
+  //small adjustments (eg dynamic rate control) keep the current kernel and history.
+  if(stages(ratio) != _stages.size() || fabs(max(1.0, _ratio) / _scale - 1.0) > 0.05) design();
+}
+
+inline auto Sinc::pending() const -> bool {
+  return _samples.pending();
+}
+
+inline auto Sinc::size() const -> u32 {
+  return _samples.size();
+}
+
+inline auto Sinc::read() -> f64 {
+  return _samples.read();
+}
+
+inline auto Sinc::write(f64 sample) -> void {
+  write(&sample, 1);
+}
+
+inline auto Sinc::write(const f64 samples[], u32 count) -> void {
+  for(auto& stage : _stages) {
+    if(stage.buffer.size() < stage.size + count) stage.buffer.resize(stage.size + count);
+    if(_decimated.size() < count) _decimated.resize(count);
+    auto buffer = stage.buffer.data();
+    memory::copy(buffer + stage.size, samples, count * sizeof(f64));
+    stage.size += count;
+
+    //the coefficients are copied locally, as the compiler cannot otherwise prove that the output stores
+    //leave them unchanged; plain loops let the inner loop fully unroll.
+    static constexpr u32 center = HalfbandTaps / 2;
+    static constexpr u32 pairs = HalfbandTaps / 4 + 1;
+    f64 halfband[pairs];
+    for(u32 tap = 0; tap < pairs; tap++) halfband[tap] = _halfband[tap];
+    auto decimated = _decimated.data();
+    u32 outputs = (stage.size - (HalfbandTaps - 1)) / 2;
+    for(u32 n = 0; n < outputs; n++) {
+      auto window = buffer + n * 2;
+      f64 output = 0.5 * window[center];
+      for(u32 tap = 0; tap < pairs; tap++) {
+        output += halfband[tap] * (window[center - 1 - tap * 2] + window[center + 1 + tap * 2]);
+      }
+      decimated[n] = output;
+    }
+
+    stage.size -= outputs * 2;
+    memory::move(buffer, buffer + outputs * 2, stage.size * sizeof(f64));
+    samples = _decimated.data();
+    count = outputs;
+  }
+
+  for(u32 n : range(count)) resample(samples[n]);
+}
+
+inline auto Sinc::serialize(serializer& s) -> void {
+  s(_inputFrequency);
+  s(_outputFrequency);
+  if(s.reading()) design();
+  s(_fraction);
+  s(_offset);
+  s(array_span<f32>{_history.data(), _history.size()});
+  s(_samples);
+  for(auto& stage : _stages) {
+    s(stage.size);
+    if(stage.buffer.size() < stage.size) stage.buffer.resize(stage.size);
+    s(array_span<f64>{stage.buffer.data(), stage.size});
+  }
+}
+
+inline auto Sinc::resample(f64 sample) -> void {
+  auto& mu = _fraction;
+
+  _history[_offset] = sample;
+  _history[_offset + _taps] = sample;
+  if(++_offset == _taps) _offset = 0;
+  auto window = _history.data() + _offset;
+
+  //output samples fall between window[_taps / 2 - 1] and window[_taps / 2].
+  while(mu < 1.0) {
+    u32 phase = mu * _phases;
+    _samples.write(convolve(_coefficients.data() + phase * _taps, window));
+    mu += _ratio;
+  }
+
+  mu -= 1.0;
+}
+
+//number of halfband stages: the sinc kernel is left with a ratio between 2 and 4.
+inline auto Sinc::stages(f64 ratio) -> u32 {
+  u32 stages = 0;
+  while(ratio >= 4.0) ratio /= 2.0, stages++;
+  return stages;
+}
+
+inline auto Sinc::design() -> void {
+  f64 ratio = _inputFrequency / _outputFrequency;
+  _stages.resize(stages(ratio));
+  for(auto& stage : _stages) {
+    stage.buffer.resize(HalfbandTaps - 1);
+    for(auto& sample : stage.buffer) sample = 0.0;
+    stage.size = HalfbandTaps - 1;
+  }
+  _ratio = ratio / (1 << _stages.size());
+  _scale = max(1.0, _ratio);
+  _fraction = 0.0;
+  _offset = 0;
+
+  //Kaiser-windowed halfband, with the odd taps normalized so that the filter has unity gain at DC.
+  f64 sum = 0.0;
+  for(u32 n : range(HalfbandTaps / 4 + 1)) {
+    f64 x = 2 * n + 1;
+    f64 t = x / (HalfbandTaps / 2 + 1);
+    _halfband[n] = (n & 1 ? -1.0 : 1.0) / (Math::Pi * x) * bessel(HalfbandBeta * sqrt(1.0 - t * t)) / bessel(HalfbandBeta);
+    sum += _halfband[n];
+  }
+  for(auto& tap : _halfband) tap *= 0.25 / sum;
+
+  //the kernel spans 2 * Crossings output periods, rounded up to whole SIMD vectors.
+  u32 half = ceil(Crossings * _scale);
+  _taps = ((half + 3) & ~3u) * 2;
+  //the phase count keeps the table near 32K coefficients: high ratios need long kernels,
+  //but the fine timing resolution matters only when the input is close to the output rate.
+  _phases = max(16u, u32(1024.0 / _scale));
+
+  _coefficients.resize(_phases * _taps);
+  _history.resize(_taps * 2);
+  for(auto& sample : _history) sample = 0.0;
+
+  f64 cutoff = Cutoff / _scale;  //relative to the input Nyquist frequency
+  f64 radius = _taps / 2;
+  vector<f64> kernel;
+  kernel.resize(_taps);
+  for(u32 phase : range(_phases)) {
+    f64 mu = (f64)phase / _phases;
+    auto row = _coefficients.data() + phase * _taps;
+    f64 sum = 0.0;
+    for(u32 tap : range(_taps)) {
+      f64 x = tap - (radius - 1) - mu;  //distance from the output sample, in input samples
+      f64 t = x / radius;
+      f64 window = fabs(t) < 1.0 ? bessel(Beta * sqrt(1.0 - t * t)) / bessel(Beta) : 0.0;
+      f64 sinc = x ? sin(Math::Pi * cutoff * x) / (Math::Pi * cutoff * x) : 1.0;
+      kernel[tap] = sinc * window;
+      sum += kernel[tap];
+    }
+    //normalize each phase to unity gain at DC.
+    for(u32 tap : range(_taps)) row[tap] = kernel[tap] / sum;
+  }
+}
+
+inline auto Sinc::convolve(const f32* coefficients, const f32* samples) const -> f64 {
+  u32 n = 0;
+  #if defined(__AVX__)
+  auto a = _mm256_setzero_ps();
+  auto b = _mm256_setzero_ps();
+  for(; n + 16 <= _taps; n += 16) {
+    a = _mm256_add_ps(a, _mm256_mul_ps(_mm256_loadu_ps(coefficients + n + 0), _mm256_loadu_ps(samples + n + 0)));
+    b = _mm256_add_ps(b, _mm256_mul_ps(_mm256_loadu_ps(coefficients + n + 8), _mm256_loadu_ps(samples + n + 8)));
+  }
+  auto sum = _mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1));
+  sum = _mm_add_ps(sum, _mm_add_ps(_mm256_castps256_ps128(b), _mm256_extractf128_ps(b, 1)));
+  #elif defined(__SSE2__)
+  auto sum = _mm_setzero_ps();
+  #endif
+  #if defined(__SSE2__)
+  for(; n + 4 <= _taps; n += 4) {
+    sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(coefficients + n), _mm_loadu_ps(samples + n)));
+  }
+  sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+  sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+  f64 output = _mm_cvtss_f32(sum);
+  #else
+  f64 output = 0.0;
+  #endif
+  for(; n < _taps; n++) output += coefficients[n] * samples[n];
+  return output;
+}
+
+//zeroth-order modified Bessel function of the first kind, used by the Kaiser window.
+inline auto Sinc::bessel(f64 x) -> f64 {
+  f64 sum = 1.0;
+  f64 term = 1.0;
+  for(u32 k = 1; k < 32; k++) {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+    if(term < sum * 1e-12) break;
+  }
+  return sum;
+}
+
+}
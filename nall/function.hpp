@@ -1,11 +1,15 @@
 #pragma once
 
+#include <new>
 #include <nall/traits.hpp>
 
 namespace nall {
 
 template<typename T> struct function;
 
+//callables that are trivially copyable and fit in Capacity bytes (function pointers, bound member
+//function pointers and small lambdas) are stored inline and invoked through a single function pointer.
+//larger or non-trivial callables are heap allocated.
 template<typename R, typename... P> struct function<auto (P...) -> R> {
   using cast = auto (*)(P...) -> R;
 
@@ -18,61 +22,84 @@ template<typename R, typename... P> struct function<auto (P...) -> R> {
 
   function() {}
   function(const function& source) { operator=(source); }
-  function(auto (*function)(P...) -> R) { callback = new global(function); }
-  template<typename C> function(auto (C::*function)(P...) -> R, C* object) { callback = new member<C>(function, object); }
-  template<typename C> function(auto (C::*function)(P...) const -> R, C* object) { callback = new member<C>((auto (C::*)(P...) -> R)function, object); }
-  template<typename L, typename = enable_if_t<is_compatible<L>::value>> function(const L& object) { callback = new lambda<L>(object); }
-  explicit function(void* function) { if(function) callback = new global((auto (*)(P...) -> R)function); }
-  ~function() { if(callback) delete callback; }
+  function(function&& source) { operator=(move(source)); }
+  function(auto (*function)(P...) -> R) { assign(global{function}); }
+  template<typename C> function(auto (C::*function)(P...) -> R, C* object) { assign(member<C>{function, object}); }
+  template<typename C> function(auto (C::*function)(P...) const -> R, C* object) { assign(member<C>{(auto (C::*)(P...) -> R)function, object}); }
+  template<typename L, typename = enable_if_t<is_compatible<L>::value>> function(const L& object) { assign(object); }
+  explicit function(void* function) { if(function) assign(global{(cast)function}); }
+  ~function() { reset(); }
 
-  explicit operator bool() const { return callback; }
-  auto operator()(P... p) const -> R { return (*callback)(forward<P>(p)...); }
-  auto reset() -> void { if(callback) { delete callback; callback = nullptr; } }
+  explicit operator bool() const { return invoke; }
+  auto operator()(P... p) const -> R { return invoke(&storage, forward<P>(p)...); }
+  auto reset() -> void { if(release) release(&storage); invoke = nullptr; clone = nullptr; release = nullptr; }
 
   auto operator=(const function& source) -> function& {
     if(this != &source) {
-      if(callback) { delete callback; callback = nullptr; }
-      if(source.callback) callback = source.callback->copy();
+      reset();
+      if(source.clone) source.clone(&storage, &source.storage);
+      else storage = source.storage;
+      invoke = source.invoke;
+      clone = source.clone;
+      release = source.release;
+    }
+    return *this;
+  }
+
+  auto operator=(function&& source) -> function& {
+    if(this != &source) {
+      reset();
+      //inline callables are trivially copyable, and heap callables are owned through a pointer.
+      storage = source.storage;
+      invoke = source.invoke;
+      clone = source.clone;
+      release = source.release;
+      source.invoke = nullptr;
+      source.clone = nullptr;
+      source.release = nullptr;
     }
     return *this;
   }
 
   auto operator=(void* source) -> function& {
-    if(callback) { delete callback; callback = nullptr; }
-    callback = new global((auto (*)(P...) -> R)source);
+    reset();
+    assign(global{(cast)source});
     return *this;
   }
 
 private:
-  struct container {
-    virtual auto operator()(P... p) const -> R = 0;
-    virtual auto copy() const -> container* = 0;
-    virtual ~container() = default;
-  };
+  static constexpr u32 Capacity = 32;
 
-  container* callback = nullptr;
-
-  struct global : container {
+  struct global {
     auto (*function)(P...) -> R;
     auto operator()(P... p) const -> R { return function(forward<P>(p)...); }
-    auto copy() const -> container* { return new global(function); }
-    global(auto (*function)(P...) -> R) : function(function) {}
   };
 
-  template<typename C> struct member : container {
+  template<typename C> struct member {
     auto (C::*function)(P...) -> R;
     C* object;
     auto operator()(P... p) const -> R { return (object->*function)(forward<P>(p)...); }
-    auto copy() const -> container* { return new member(function, object); }
-    member(auto (C::*function)(P...) -> R, C* object) : function(function), object(object) {}
   };
 
-  template<typename L> struct lambda : container {
-    mutable L object;
-    auto operator()(P... p) const -> R { return object(forward<P>(p)...); }
-    auto copy() const -> container* { return new lambda(object); }
-    lambda(const L& object) : object(object) {}
-  };
+  template<typename L> static constexpr bool is_inline = sizeof(L) <= Capacity && alignof(L) <= alignof(void*) && is_trivially_copyable_v<L>;
+
+  template<typename L> auto assign(const L& object) -> void {
+    if constexpr(is_inline<L>) {
+      new(&storage) L(object);
+      invoke = [](void* storage, P... p) -> R { return (*(L*)storage)(forward<P>(p)...); };
+    } else {
+      new(&storage) L*(new L(object));
+      invoke = [](void* storage, P... p) -> R { return (**(L**)storage)(forward<P>(p)...); };
+      clone = [](void* target, const void* source) { new(target) L*(new L(**(L* const*)source)); };
+      release = [](void* storage) { delete *(L**)storage; };
+    }
+  }
+
+  struct Storage { alignas(void*) char data[Capacity]; };
+  mutable Storage storage;
+  auto (*invoke)(void* storage, P... p) -> R = nullptr;
+  auto (*clone)(void* target, const void* source) -> void = nullptr;  //heap callables only
+  auto (*release)(void* storage) -> void = nullptr;                   //heap callables only
 };
 
 }
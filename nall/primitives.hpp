@@ -21,6 +21,13 @@ namespace nall {
 #include <nall/primitives/literals.hpp>
 
 namespace nall {
+  template<u32 Precision> struct serializer_bulk<Natural<Precision>> {
+    static constexpr bool value = sizeof(Natural<Precision>) == sizeof(typename Natural<Precision>::utype);
+  };
+  template<u32 Precision> struct serializer_bulk<Integer<Precision>> {
+    static constexpr bool value = sizeof(Integer<Precision>) == sizeof(typename Integer<Precision>::stype);
+  };
+
   template<uint Bits> auto Natural<Bits>::integer() const -> Integer<Bits> { return Integer<Bits>(*this); }
   template<uint Bits> auto Integer<Bits>::natural() const -> Natural<Bits> { return Natural<Bits>(*this); }
 }
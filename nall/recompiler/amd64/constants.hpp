@@ -170,4 +170,10 @@
     reg64 reg;
     s32 imm;
   };
+
+  struct idx {
+    explicit idx(reg64 base, reg64 index) : base(base), index(index) {}
+    reg64 base;
+    reg64 index;
+  };
 //};
@@ -15,6 +15,13 @@
     emit.modrm(3, 2, rt & 7);
   }
 
+  //jmp reg64
+  alwaysinline auto jmp(reg64 rt) {
+    emit.rex(0, 0, 0, rt & 8);
+    emit.byte(0xff);
+    emit.modrm(3, 4, rt & 7);
+  }
+
   //lea reg64,[reg64+imm8]
   alwaysinline auto lea(reg64 rt, dis8 ds) {
     emit.rex(1, rt & 8, 0, ds.reg & 8);
@@ -411,6 +418,62 @@
   alwaysinline auto movzx(reg32 rt, reg16 rs) { op(0xb7); }
   #undef op
 
+  //[reg64+reg64] operands: rbp and r13 bases have no disp-less encoding, and use [base+index+0]
+  #define mem(rt, ds) \
+    emit.modrm((ds.base & 7) == 5, rt & 7, 4); \
+    emit.sib(0, ds.index & 7, ds.base & 7); \
+    if((ds.base & 7) == 5) emit.byte(0x00);
+
+  //mov reg32,[reg64+reg64]
+  alwaysinline auto mov(reg32 rt, idx ds) {
+    emit.rex(0, rt & 8, ds.index & 8, ds.base & 8);
+    emit.byte(0x8b);
+    mem(rt, ds);
+  }
+
+  //op reg32,byte [reg64+reg64]
+  //op reg32,word [reg64+reg64]
+  #define op(code) \
+    emit.rex(0, rt & 8, ds.index & 8, ds.base & 8); \
+    emit.byte(0x0f, code); \
+    mem(rt, ds);
+  alwaysinline auto movsxb(reg32 rt, idx ds) { op(0xbe); }
+  alwaysinline auto movzxb(reg32 rt, idx ds) { op(0xb6); }
+  alwaysinline auto movsxw(reg32 rt, idx ds) { op(0xbf); }
+  alwaysinline auto movzxw(reg32 rt, idx ds) { op(0xb7); }
+  #undef op
+
+  //mov [reg64+reg64],reg8
+  alwaysinline auto mov(idx dt, reg8 rs) {
+    emit.rex(0, rs & 8, dt.index & 8, dt.base & 8);
+    emit.byte(0x88);
+    mem(rs, dt);
+  }
+
+  //mov [reg64+reg64],reg16
+  alwaysinline auto mov(idx dt, reg16 rs) {
+    emit.byte(0x66);
+    emit.rex(0, rs & 8, dt.index & 8, dt.base & 8);
+    emit.byte(0x89);
+    mem(rs, dt);
+  }
+
+  //mov [reg64+reg64],reg32
+  alwaysinline auto mov(idx dt, reg32 rs) {
+    emit.rex(0, rs & 8, dt.index & 8, dt.base & 8);
+    emit.byte(0x89);
+    mem(rs, dt);
+  }
+  #undef mem
+
+  //bt [reg64],reg64
+  alwaysinline auto bt(dis dt, reg64 rs) {
+    emit.rex(1, rs & 8, 0, dt.reg & 8);
+    emit.byte(0x0f, 0xa3);
+    emit.modrm(0, rs & 7, dt.reg & 7);
+    if(dt.reg == rsp || dt.reg == r12) emit.sib(0, 4, 4);
+  }
+
   alwaysinline auto movsxd(reg64 rt, reg32 rs) {
     emit.rex(1, rt & 8, 0, rs & 8);
     emit.byte(0x63);
@@ -722,14 +785,51 @@
   alwaysinline auto idiv(reg64 rt) { op(7); }
   #undef op
 
+  //imul reg32,reg32,imm32
+  alwaysinline auto imul(reg32 rt, reg32 rs, imm32 is) {
+    emit.rex(0, rt & 8, 0, rs & 8);
+    emit.byte(0x69);
+    emit.modrm(3, rt & 7, rs & 7);
+    emit.dword(is.data);
+  }
+
   #define op(code) \
     emit.byte(code); \
     emit.byte(it.data);
   alwaysinline auto jmp(imm8 it) { op(0xeb); }
+  alwaysinline auto ja (imm8 it) { op(0x77); }
+  alwaysinline auto jae(imm8 it) { op(0x73); }
+  alwaysinline auto jb (imm8 it) { op(0x72); }
+  alwaysinline auto jbe(imm8 it) { op(0x76); }
+  alwaysinline auto jg (imm8 it) { op(0x7f); }
+  alwaysinline auto jge(imm8 it) { op(0x7d); }
+  alwaysinline auto jl (imm8 it) { op(0x7c); }
+  alwaysinline auto jle(imm8 it) { op(0x7e); }
   alwaysinline auto jnz(imm8 it) { op(0x75); }
   alwaysinline auto jz (imm8 it) { op(0x74); }
   #undef op
 
+  alwaysinline auto jmp(imm32 it) {
+    emit.byte(0xe9);
+    emit.dword(it.data);
+  }
+
+  #define op(code) \
+    emit.byte(0x0f); \
+    emit.byte(code); \
+    emit.dword(it.data);
+  alwaysinline auto ja (imm32 it) { op(0x87); }
+  alwaysinline auto jae(imm32 it) { op(0x83); }
+  alwaysinline auto jb (imm32 it) { op(0x82); }
+  alwaysinline auto jbe(imm32 it) { op(0x86); }
+  alwaysinline auto jg (imm32 it) { op(0x8f); }
+  alwaysinline auto jge(imm32 it) { op(0x8d); }
+  alwaysinline auto jl (imm32 it) { op(0x8c); }
+  alwaysinline auto jle(imm32 it) { op(0x8e); }
+  alwaysinline auto jnz(imm32 it) { op(0x85); }
+  alwaysinline auto jz (imm32 it) { op(0x84); }
+  #undef op
+
   //op reg8
   #define op(code) \
     emit.rex(0, 0, 0, rt & 8); \
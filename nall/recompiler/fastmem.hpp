@@ -0,0 +1,166 @@
+#pragma once
+
+//maps guest memory into a reserved region of host address space, so that generated code
+//can access it with a single [base+address] instruction.
+//everything outside the mapped ranges is left inaccessible: an access there faults, and the
+//fault handler resumes at the slow path registered for the faulting instruction, after
+//patching the instruction into a jump to that slow path for all later executions.
+
+#include <nall/map.hpp>
+#include <nall/memory.hpp>
+#include <nall/vector.hpp>
+
+#if defined(PLATFORM_LINUX) && defined(ARCHITECTURE_AMD64)
+  #include <signal.h>
+  #include <sys/mman.h>
+  #include <ucontext.h>
+  #include <unistd.h>
+#endif
+
+namespace nall::recompiler {
+
+struct fastmem {
+  #if defined(PLATFORM_LINUX) && defined(ARCHITECTURE_AMD64)
+  static constexpr bool supported = true;
+  #else
+  static constexpr bool supported = false;
+  #endif
+
+  ~fastmem() {
+    reset();
+  }
+
+  explicit operator bool() const {
+    return _base;
+  }
+
+  auto base() const -> u8* {
+    return _base;
+  }
+
+  //the backing store: every mapped range aliases this memory
+  auto memory() const -> u8* {
+    return _memory;
+  }
+
+  //reserves size bytes of inaccessible address space, and capacity bytes of backing store.
+  auto reserve(u64 size, u32 capacity) -> bool {
+    reset();
+    #if defined(PLATFORM_LINUX) && defined(ARCHITECTURE_AMD64)
+    capacity = capacity + 4095 & ~4095;
+    _descriptor = memfd_create("fastmem", 0);
+    if(_descriptor < 0) return reset(), false;
+    if(ftruncate(_descriptor, capacity) < 0) return reset(), false;
+
+    _memory = (u8*)mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _descriptor, 0);
+    if(_memory == MAP_FAILED) return _memory = nullptr, reset(), false;
+    _capacity = capacity;
+
+    _base = (u8*)mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if(_base == MAP_FAILED) return _base = nullptr, reset(), false;
+    _size = size;
+
+    install();
+    instances().append(this);
+    return true;
+    #else
+    return false;
+    #endif
+  }
+
+  //maps the backing store over [base+address, base+address+length), mirroring it as needed.
+  auto map(u64 address, u64 length) -> bool {
+    #if defined(PLATFORM_LINUX) && defined(ARCHITECTURE_AMD64)
+    if(!_base || address + length > _size) return false;
+    for(u64 offset = 0; offset < length; offset += _capacity) {
+      auto target = _base + address + offset;
+      auto bytes = min(length - offset, (u64)_capacity);
+      if(mmap(target, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, _descriptor, 0) == MAP_FAILED) return false;
+    }
+    return true;
+    #else
+    return false;
+    #endif
+  }
+
+  //registers the slow path to resume at when the instruction at access faults.
+  //the instruction must be at least five bytes long, so that it can be patched into a jmp rel32.
+  auto recover(u8* access, u8* handler) -> void {
+    _sites.insert(access, handler);
+  }
+
+  //forgets all registered instructions, when the code containing them is discarded.
+  auto forget() -> void {
+    _sites.reset();
+  }
+
+  auto reset() -> void {
+    #if defined(PLATFORM_LINUX) && defined(ARCHITECTURE_AMD64)
+    instances().removeByValue(this);
+    if(_base) munmap(_base, _size);
+    if(_memory) munmap(_memory, _capacity);
+    if(_descriptor >= 0) close(_descriptor);
+    #endif
+    _sites.reset();
+    _base = nullptr;
+    _size = 0;
+    _memory = nullptr;
+    _capacity = 0;
+    _descriptor = -1;
+  }
+
+private:
+  #if defined(PLATFORM_LINUX) && defined(ARCHITECTURE_AMD64)
+  static auto instances() -> vector<fastmem*>& {
+    static vector<fastmem*> instances;
+    return instances;
+  }
+
+  static auto previous() -> struct sigaction& {
+    static struct sigaction previous{};
+    return previous;
+  }
+
+  static auto install() -> void {
+    static bool installed = false;
+    if(installed) return;
+    installed = true;
+
+    struct sigaction handler{};
+    handler.sa_sigaction = fault;
+    handler.sa_flags = SA_SIGINFO | SA_NODEFER;
+    sigemptyset(&handler.sa_mask);
+    sigaction(SIGSEGV, &handler, &previous());
+  }
+
+  static auto fault(int signal, siginfo_t* info, void* context) -> void {
+    auto address = (u8*)info->si_addr;
+    auto& rip = ((ucontext_t*)context)->uc_mcontext.gregs[REG_RIP];
+    for(auto instance : instances()) {
+      if(address < instance->_base || address >= instance->_base + instance->_size) continue;
+      if(auto handler = instance->_sites.find((u8*)rip)) {
+        auto access = (u8*)rip;
+        access[0] = 0xe9;  //jmp rel32
+        memory::writel<4>(access + 1, u32(handler() - (access + 5)));
+        rip = (greg_t)handler();
+        return;
+      }
+    }
+
+    //not a fastmem access: let the previous handler deal with it
+    auto& next = previous();
+    if(next.sa_flags & SA_SIGINFO) return next.sa_sigaction(signal, info, context);
+    if(next.sa_handler != SIG_DFL && next.sa_handler != SIG_IGN) return next.sa_handler(signal);
+    sigaction(SIGSEGV, &next, nullptr);  //returning re-executes the access, which now terminates
+  }
+  #endif
+
+  u8* _base = nullptr;
+  u64 _size = 0;
+  u8* _memory = nullptr;
+  u32 _capacity = 0;
+  int _descriptor = -1;
+  nall::map<u8*, u8*> _sites;  //faulting instruction -> slow path
+};
+
+}
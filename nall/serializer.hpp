@@ -13,6 +13,7 @@
 
 #include <nall/array.hpp>
 #include <nall/bit.hpp>
+#include <nall/intrinsics.hpp>
 #include <nall/range.hpp>
 #include <nall/stdint.hpp>
 #include <nall/traits.hpp>
@@ -30,6 +31,14 @@ struct has_serialize {
 };
 template<typename T> constexpr bool has_serialize_v = has_serialize<T>::value;
 
+//types whose in-memory representation is identical to their serialized representation on
+//little-endian hosts; arrays of these types can be copied in bulk rather than per element.
+template<typename T>
+struct serializer_bulk {
+  static constexpr bool value = is_integral_v<T> && !is_same_v<T, bool>;
+};
+template<typename T> constexpr bool serializer_bulk_v = serializer_bulk<T>::value;
+
 struct serializer {
   explicit operator bool() const {
     return _size;
@@ -88,13 +97,11 @@ struct serializer {
   }
 
   template<typename T, s32 N> auto operator()(T (&array)[N]) -> serializer& {
-    for(auto& value : array) operator()(value);
-    return *this;
+    return elements(array, N);
   }
 
   template<typename T> auto operator()(array_span<T> array) -> serializer& {
-    for(auto& value : array) operator()(value);
-    return *this;
+    return elements(array.data(), array.size());
   }
 
   auto operator=(const serializer& s) -> serializer& {
@@ -144,6 +151,24 @@ struct serializer {
   }
 
 private:
+  template<typename T> auto elements(T* values, u32 count) -> serializer& {
+    #if defined(ENDIAN_LITTLE)
+    if constexpr(serializer_bulk_v<T>) {
+      u32 size = count * sizeof(T);
+      reserve(_size + size);
+      if(writing()) {
+        memory::copy(_data + _size, values, size);
+      } else if(reading()) {
+        memory::copy(values, _data + _size, size);
+      }
+      _size += size;
+      return *this;
+    }
+    #endif
+    for(u32 n : range(count)) operator()(values[n]);
+    return *this;
+  }
+
   template<typename T> auto integer(T& value) -> serializer& {
     enum : u32 { size = std::is_same<bool, T>::value ? 1 : sizeof(T) };
     reserve(_size + size);
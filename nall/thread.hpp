@@ -10,10 +10,14 @@
 #include <nall/function.hpp>
 #include <nall/intrinsics.hpp>
 
+#include <condition_variable>
+
 namespace nall {
   using mutex = std::mutex;
   using recursive_mutex = std::recursive_mutex;
+  using condition_variable = std::condition_variable;
   template<typename T> using lock_guard = std::lock_guard<T>;
+  template<typename T> using unique_lock = std::unique_lock<T>;
   template<typename T> using atomic = std::atomic<T>;
 }
 
@@ -29,6 +33,7 @@ struct thread {
   static auto create(const function<void (uintptr)>& callback, uintptr parameter = 0, u32 stacksize = 0) -> thread;
   static auto detach() -> void;
   static auto exit() -> void;
+  static auto concurrency() -> u32;
 
   struct context {
     function<auto (uintptr) -> void> callback;
@@ -73,6 +78,10 @@ inline auto thread::exit() -> void {
   pthread_exit(nullptr);
 }
 
+inline auto thread::concurrency() -> u32 {
+  return max(1l, sysconf(_SC_NPROCESSORS_ONLN));
+}
+
 }
 
 #elif defined(API_WINDOWS)
@@ -86,6 +95,7 @@ struct thread {
   static auto create(const function<void (uintptr)>& callback, uintptr parameter = 0, u32 stacksize = 0) -> thread;
   static auto detach() -> void;
   static auto exit() -> void;
+  static auto concurrency() -> u32;
 
   struct context {
     function<auto (uintptr) -> void> callback;
@@ -146,6 +156,12 @@ inline auto thread::exit() -> void {
   ExitThread(0);
 }
 
+inline auto thread::concurrency() -> u32 {
+  SYSTEM_INFO information;
+  GetSystemInfo(&information);
+  return max(1u, (u32)information.dwNumberOfProcessors);
+}
+
 }
 
 #endif
@@ -32,6 +32,8 @@ namespace nall {
   using std::is_same_v;
   using std::is_signed;
   using std::is_signed_v;
+  using std::is_trivially_copyable;
+  using std::is_trivially_copyable_v;
   using std::is_unsigned;
   using std::is_unsigned_v;
   using std::move;